@@ -0,0 +1,275 @@
+## @file
+# Convert the FPDT Firmware Basic Boot Performance Table (FBPT) into folded
+# stacks that flame graph tools read.
+#
+# The FBPT holds the performance records logged by PeiPerformanceLib,
+# DxeCorePerformanceLib and SmmCorePerformanceLib. Each start record is paired
+# with its end record, and the resulting intervals are nested by time, so that
+# for example a driver binding Start() shows up under the StartImage() of the
+# driver that connected it, and that under the DXE phase. Each line of the
+# output is a semicolon separated stack followed by the time spent in the
+# innermost frame itself.
+#
+# The FBPT can be dumped from memory at the address given in the FPDT ACPI
+# table. Folded stacks of many boots can be combined by passing several input
+# files, or by concatenating the outputs.
+#
+# Copyright (c) 2026, agent. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+'''
+FpdtFlameGraph
+'''
+from __future__ import print_function
+
+import argparse
+import re
+import struct
+import sys
+import uuid
+
+#
+# Globals for help information
+#
+__prog__        = 'FpdtFlameGraph'
+__copyright__   = 'Copyright (c) 2026, agent. All rights reserved.'
+__description__ = 'Convert one or more FPDT boot performance tables to folded stacks for flame graphs.\n'
+
+#
+# FPDT record types, from MdePkg/Include/IndustryStandard/Acpi50.h and
+# MdeModulePkg/Include/Guid/ExtendedFirmwarePerformance.h
+#
+FPDT_BOOT_PERFORMANCE_TABLE_SIGNATURE = b'FBPT'
+FPDT_GUID_EVENT_TYPE                  = 0x1010
+FPDT_DYNAMIC_STRING_EVENT_TYPE        = 0x1011
+FPDT_DUAL_GUID_STRING_EVENT_TYPE      = 0x1012
+FPDT_GUID_QWORD_EVENT_TYPE            = 0x1013
+FPDT_GUID_QWORD_STRING_EVENT_TYPE     = 0x1014
+
+#
+# Progress IDs, from MdePkg/Include/Library/PerformanceLib.h
+#
+MODULE_START_ID             = 0x01
+MODULE_LOADIMAGE_START_ID   = 0x03
+MODULE_DB_START_ID          = 0x05
+MODULE_DB_SUPPORT_START_ID  = 0x07
+MODULE_DB_STOP_START_ID     = 0x09
+PERF_EVENTSIGNAL_START_ID   = 0x10
+PERF_CALLBACK_START_ID      = 0x20
+PERF_CROSSMODULE_START_ID   = 0x50
+
+#
+# Tokens used for the module records, the same as the ones the dp command shows.
+#
+ModuleTokens = {
+    MODULE_START_ID            : 'StartImage:',
+    MODULE_LOADIMAGE_START_ID  : 'LoadImage:',
+    MODULE_DB_START_ID         : 'DB:Start:',
+    MODULE_DB_SUPPORT_START_ID : 'DB:Support:',
+    MODULE_DB_STOP_START_ID    : 'DB:Stop:'
+    }
+
+#
+# Common part of the extended records: Type, Length, Revision, ProgressID,
+# ApicID, Timestamp and GUID.
+#
+RecordHeader = struct.Struct ('<HBBHIQ16s')
+
+class Record (object):
+    def __init__ (self, Type, ProgressId, ApicId, Timestamp, Guid, Guid2 = None, String = ''):
+        self.Type       = Type
+        self.ProgressId = ProgressId
+        self.ApicId     = ApicId
+        self.Timestamp  = Timestamp
+        self.Guid       = Guid
+        self.Guid2      = Guid2
+        self.String     = String
+
+    def IsStart (self):
+        #
+        # Same rule as the dp command: module records start with an odd ID,
+        # the other records start with an ID that is a multiple of 0x10.
+        #
+        if self.ProgressId < PERF_EVENTSIGNAL_START_ID:
+            return (self.ProgressId & 0x01) != 0
+        return (self.ProgressId & 0x0F) == 0
+
+    def StartId (self):
+        if self.IsStart ():
+            return self.ProgressId
+        if self.ProgressId < PERF_EVENTSIGNAL_START_ID:
+            return self.ProgressId - 1
+        return self.ProgressId & ~0x0F
+
+    def Key (self):
+        #
+        # The fields that a start record and its end record have in common.
+        #
+        StartId = self.StartId ()
+        if StartId < PERF_EVENTSIGNAL_START_ID:
+            return (StartId, self.Guid)
+        if StartId == PERF_CROSSMODULE_START_ID:
+            return (StartId, self.String)
+        return (StartId, self.Guid, self.Guid2, self.String)
+
+class Interval (object):
+    def __init__ (self, Name, ApicId, Start, End):
+        self.Name     = Name
+        self.ApicId   = ApicId
+        self.Start    = Start
+        self.End      = End
+        self.Children = 0
+
+def ParseString (Buffer):
+    return Buffer.split (b'\0', 1)[0].decode ('ascii', 'replace').replace (';', ':').strip ()
+
+def ParseRecords (Buffer):
+    if Buffer[0:4] == FPDT_BOOT_PERFORMANCE_TABLE_SIGNATURE:
+        Length = struct.unpack_from ('<I', Buffer, 4)[0]
+        Buffer = Buffer[8:Length]
+
+    Records = []
+    Offset  = 0
+    while Offset + 4 <= len (Buffer):
+        Type, Length = struct.unpack_from ('<HB', Buffer, Offset)
+        if Length == 0:
+            break
+        Data    = Buffer[Offset:Offset + Length]
+        Offset += Length
+        if Type < FPDT_GUID_EVENT_TYPE or Type > FPDT_GUID_QWORD_STRING_EVENT_TYPE or len (Data) < RecordHeader.size:
+            #
+            # Skip the basic boot record and the records of other producers.
+            #
+            continue
+        _, _, _, ProgressId, ApicId, Timestamp, Guid = RecordHeader.unpack_from (Data)
+        Guid   = str (uuid.UUID (bytes_le = Guid)).upper ()
+        Guid2  = None
+        String = ''
+        if Type == FPDT_DYNAMIC_STRING_EVENT_TYPE:
+            String = ParseString (Data[RecordHeader.size:])
+        elif Type == FPDT_DUAL_GUID_STRING_EVENT_TYPE:
+            Guid2  = str (uuid.UUID (bytes_le = Data[RecordHeader.size:RecordHeader.size + 16])).upper ()
+            String = ParseString (Data[RecordHeader.size + 16:])
+        elif Type == FPDT_GUID_QWORD_STRING_EVENT_TYPE:
+            String = ParseString (Data[RecordHeader.size + 8:])
+        Records.append (Record (Type, ProgressId, ApicId, Timestamp, Guid, Guid2, String))
+    return Records
+
+def GetName (Start, GuidNames):
+    Module  = GuidNames.get (Start.Guid, Start.Guid)
+    StartId = Start.StartId ()
+    if StartId in ModuleTokens:
+        #
+        # Records logged with PcdEdkiiFpdtStringRecordEnableOnly carry the module
+        # name in place of the token.
+        #
+        if Start.Type == FPDT_DYNAMIC_STRING_EVENT_TYPE and Start.String != '':
+            Module = Start.String
+        return ModuleTokens[StartId] + Module
+    if StartId == PERF_CROSSMODULE_START_ID:
+        return Start.String
+    if StartId in (PERF_EVENTSIGNAL_START_ID, PERF_CALLBACK_START_ID):
+        return '{Module}:{Function}({Event})'.format (Module = Module, Function = Start.String, Event = GuidNames.get (Start.Guid2, Start.Guid2))
+    return '{Module}:{Token}'.format (Module = Module, Token = Start.String)
+
+def BuildIntervals (Records, GuidNames):
+    Intervals = []
+    Pending   = {}
+    for Item in Records:
+        if Item.ProgressId == 0:
+            #
+            # Records with ID 0 only have an end time stamp.
+            #
+            continue
+        if Item.IsStart ():
+            Pending.setdefault (Item.Key (), []).append (Item)
+            continue
+        #
+        # Pair the end record with the last start record that has the same key.
+        #
+        Starts = Pending.get (Item.Key ())
+        if not Starts:
+            continue
+        Start = Starts.pop ()
+        if Item.Timestamp >= Start.Timestamp:
+            Intervals.append (Interval (GetName (Start, GuidNames), Start.ApicId, Start.Timestamp, Item.Timestamp))
+    return Intervals
+
+def FoldIntervals (Intervals, Stacks, Divisor):
+    ApicIds = set (Item.ApicId for Item in Intervals)
+    for ApicId in sorted (ApicIds):
+        Root = []
+        if len (ApicIds) > 1:
+            Root = ['ApicId 0x{Id:X}'.format (Id = ApicId)]
+        Stack = []
+        Items = sorted ([Item for Item in Intervals if Item.ApicId == ApicId], key = lambda Item: (Item.Start, -Item.End))
+        for Item in Items + [None]:
+            #
+            # Close the intervals that do not contain the current one.
+            #
+            while Stack and (Item is None or Item.Start >= Stack[-1].End or Item.End > Stack[-1].End):
+                Done = Stack.pop ()
+                Self = (Done.End - Done.Start - Done.Children) // Divisor
+                if Self > 0:
+                    Path = ';'.join (Root + [Frame.Name for Frame in Stack] + [Done.Name])
+                    Stacks[Path] = Stacks.get (Path, 0) + Self
+            if Item is None:
+                break
+            if Stack:
+                Stack[-1].Children += Item.End - Item.Start
+            Stack.append (Item)
+
+def ReadGuidNames (File):
+    GuidNames = {}
+    for Line in File:
+        Match = re.match (r'\s*([0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12})\s+(\S+)', Line)
+        if Match:
+            GuidNames[Match.group (1).upper ()] = Match.group (2)
+    return GuidNames
+
+if __name__ == '__main__':
+    #
+    # Create command line argument parser object
+    #
+    parser = argparse.ArgumentParser (prog = __prog__,
+                                      description = __description__ + __copyright__,
+                                      conflict_handler = 'resolve')
+    parser.add_argument ("-i", "--input", dest = 'InputFile', type = argparse.FileType ('rb'), action = 'append', required = True,
+                         help = "Input FBPT binary filename.  The stacks of multiple input files are added up.")
+    parser.add_argument ("-o", "--output", dest = 'OutputFile', type = argparse.FileType ('w'), default = sys.stdout,
+                         help = "Output filename for the folded stacks.  Default is stdout.")
+    parser.add_argument ("-g", "--guid-xref", dest = 'GuidXref', type = argparse.FileType ('r'), action = 'append', default = [],
+                         help = "Guid.xref file of the firmware build, used to name the modules and events.")
+    parser.add_argument ("-u", "--unit", dest = 'Unit', default = 'us', choices = ['ns', 'us', 'ms'],
+                         help = "Unit of the sample counts.  Default is us.")
+    parser.add_argument ("-v", "--verbose", dest = 'Verbose', action = "store_true",
+                         help = "Increase output messages")
+
+    #
+    # Parse command line arguments
+    #
+    args = parser.parse_args ()
+
+    GuidNames = {}
+    for File in args.GuidXref:
+        GuidNames.update (ReadGuidNames (File))
+        File.close ()
+
+    Divisor = {'ns': 1, 'us': 1000, 'ms': 1000000}[args.Unit]
+    Stacks  = {}
+    for File in args.InputFile:
+        try:
+            Buffer = File.read ()
+            File.close ()
+        except:
+            print ('FpdtFlameGraph: error: can not read binary input file {File}'.format (File = File.name))
+            sys.exit (1)
+        Records   = ParseRecords (Buffer)
+        Intervals = BuildIntervals (Records, GuidNames)
+        if args.Verbose:
+            print ('FpdtFlameGraph: {File}: {Records} records, {Intervals} intervals'.format (File = File.name, Records = len (Records), Intervals = len (Intervals)), file = sys.stderr)
+        FoldIntervals (Intervals, Stacks, Divisor)
+
+    for Path in sorted (Stacks):
+        args.OutputFile.write ('{Path} {Count}\n'.format (Path = Path, Count = Stacks[Path]))
@@ -583,18 +583,29 @@ Decode (
 
       DataIdx     = Sd->mOutBuf - DecodeP (Sd) - 1;
 
-      BytesRemain--;
-      while ((INT16) (BytesRemain) >= 0) {
-        if (Sd->mOutBuf >= Sd->mOrigSize) {
-          return ;
-        }
-        if (DataIdx >= Sd->mOrigSize) {
-          Sd->mBadTableFlag = (UINT16) BAD_TABLE;
-          return ;
-        }
-        Sd->mDstBase[Sd->mOutBuf++] = Sd->mDstBase[DataIdx++];
-
+      if ((DataIdx < Sd->mOutBuf) &&
+          ((UINT32) BytesRemain <= Sd->mOutBuf - DataIdx) &&
+          ((UINT32) BytesRemain <= Sd->mOrigSize - Sd->mOutBuf)) {
+        //
+        // The string neither overlaps the bytes being written nor runs past
+        // the end of mDstBase, so copy it in one go.
+        //
+        memcpy (Sd->mDstBase + Sd->mOutBuf, Sd->mDstBase + DataIdx, BytesRemain);
+        Sd->mOutBuf += BytesRemain;
+      } else {
         BytesRemain--;
+        while ((INT16) (BytesRemain) >= 0) {
+          if (Sd->mOutBuf >= Sd->mOrigSize) {
+            return ;
+          }
+          if (DataIdx >= Sd->mOrigSize) {
+            Sd->mBadTableFlag = (UINT16) BAD_TABLE;
+            return ;
+          }
+          Sd->mDstBase[Sd->mOutBuf++] = Sd->mDstBase[DataIdx++];
+
+          BytesRemain--;
+        }
       }
       //
       // Once mOutBuf is fully filled, directly return
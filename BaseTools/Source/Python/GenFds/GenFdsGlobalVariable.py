@@ -14,6 +14,9 @@ from __future__ import absolute_import
 
 import Common.LongFilePathOs as os
 import sys
+import hashlib
+import shutil
+import tempfile
 from sys import stdout
 from subprocess import PIPE,Popen
 from struct import Struct
@@ -73,6 +76,16 @@ class GenFdsGlobalVariable:
     ModuleFile = ''
     EnableGenfdsMultiThread = True
 
+    #
+    # Directory of the content-addressed cache of tool outputs, keyed by the
+    # tool, its arguments and the contents of its input files. The cache is
+    # disabled when it is empty. It only covers tools that GenFds runs itself,
+    # not the commands written to makefiles in multi-thread mode, so it can only
+    # be set together with --no-genfds-multi-thread.
+    #
+    GenFdsCacheDir = ''
+    ToolHashDict = {}
+
     #
     # The list whose element are flags to indicate if large FFS or SECTION files exist in FV.
     # At the beginning of each generation of FV, false flag is appended to the list,
@@ -500,7 +513,7 @@ class GenFdsGlobalVariable:
             else:
                 if not GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                     return
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate section")
         else:
             Cmd += ("-o", Output)
             Cmd += Input
@@ -515,7 +528,7 @@ class GenFdsGlobalVariable:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             elif GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate section")
                 if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
                     GenFdsGlobalVariable.LargeFileInFvFlags):
                     GenFdsGlobalVariable.LargeFileInFvFlags[-1] = True
@@ -571,7 +584,7 @@ class GenFdsGlobalVariable:
         else:
             if not GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 return
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate FFS")
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate FFS")
 
     @staticmethod
     def GenerateFirmwareVolume(Output, Input, BaseAddress=None, ForceRebase=None, Capsule=False, Dump=False,
@@ -640,7 +653,7 @@ class GenFdsGlobalVariable:
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
         else:
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate firmware image")
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate firmware image")
 
     @staticmethod
     def GenerateOptionRom(Output, EfiInput, BinaryInput, Compress=False, ClassCode=None,
@@ -683,7 +696,7 @@ class GenFdsGlobalVariable:
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
         else:
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate option rom")
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to generate option rom")
 
     @staticmethod
     def GuidTool(Output, Input, ToolPath, Options='', returnValue=[], IsMakefile=False):
@@ -699,7 +712,91 @@ class GenFdsGlobalVariable:
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
         else:
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to call " + ToolPath, returnValue)
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, "Failed to call " + ToolPath, returnValue)
+
+    ## GetToolCacheKey()
+    #
+    #   The key covers the tool binary, every argument that is not an existing
+    #   file, and the contents of every argument that is an existing file. File
+    #   paths themselves are not part of the key, so a cache directory can be
+    #   shared between workspaces on one build host.
+    #
+    #   @param  Cmd             Tool command line
+    #   @param  Output          Path of output file
+    #
+    #   @retval string          Hex digest identifying the tool output
+    #
+    @staticmethod
+    def GetToolCacheKey(Cmd, Output):
+        Key = hashlib.sha256()
+        Tool = Cmd[0]
+        if Tool not in GenFdsGlobalVariable.ToolHashDict:
+            ToolHash = Tool
+            ToolPath = Tool if os.path.isfile(Tool) else shutil.which(Tool)
+            if ToolPath:
+                with open(ToolPath, 'rb') as Fd:
+                    ToolHash = hashlib.sha256(Fd.read()).hexdigest()
+            GenFdsGlobalVariable.ToolHashDict[Tool] = ToolHash
+        Key.update(GenFdsGlobalVariable.ToolHashDict[Tool].encode('utf-8'))
+        for Arg in Cmd[1:]:
+            if Arg == Output:
+                Key.update(b'\0<OUTPUT>')
+            elif os.path.isfile(Arg):
+                with open(Arg, 'rb') as Fd:
+                    Key.update(b'\0<FILE>' + hashlib.sha256(Fd.read()).digest())
+            else:
+                Key.update(b'\0' + Arg.encode('utf-8'))
+        return Key.hexdigest()
+
+    ## CallCachedTool()
+    #
+    #   Reuse Output from the GenFds cache directory when the same tool was
+    #   already run with the same arguments and input contents, otherwise call
+    #   the tool and store its output in the cache.
+    #
+    @staticmethod
+    def CallCachedTool (cmd, Output, errorMess, returnValue=[]):
+        if not GenFdsGlobalVariable.GenFdsCacheDir:
+            GenFdsGlobalVariable.CallExternalTool(cmd, errorMess, returnValue)
+            return
+
+        Key = GenFdsGlobalVariable.GetToolCacheKey(cmd, Output)
+        CacheFile = os.path.join(GenFdsGlobalVariable.GenFdsCacheDir, Key[:2], Key)
+        if os.path.isfile(CacheFile):
+            GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s is restored from cache %s" % (Output, CacheFile))
+            CreateDirectory(os.path.dirname(Output))
+            shutil.copyfile(CacheFile, Output)
+            #
+            # Only successful runs are cached, so report success like the tool
+            # would have.
+            #
+            if returnValue != []:
+                returnValue[0] = 0
+            return
+
+        GenFdsGlobalVariable.CallExternalTool(cmd, errorMess, returnValue)
+        if (returnValue != [] and returnValue[0] != 0) or not os.path.isfile(Output):
+            return
+
+        #
+        # Copy to a temporary file first, so that a concurrent build sharing the
+        # cache directory never sees a partially written entry.
+        #
+        CacheDir = os.path.dirname(CacheFile)
+        if not CreateDirectory(CacheDir):
+            return
+        TempFile = None
+        try:
+            with open(Output, 'rb') as Src, tempfile.NamedTemporaryFile(dir=CacheDir, delete=False) as Dst:
+                TempFile = Dst.name
+                shutil.copyfileobj(Src, Dst)
+            if not os.path.exists(CacheFile):
+                os.rename(TempFile, CacheFile)
+                TempFile = None
+        except (IOError, OSError):
+            pass
+        if TempFile and os.path.exists(TempFile):
+            os.remove(TempFile)
 
     @staticmethod
     def CallExternalTool (cmd, errorMess, returnValue=[]):
@@ -719,6 +719,7 @@ class Build():
         GlobalData.gBinCacheDest   = BuildOptions.BinCacheDest
         GlobalData.gBinCacheSource = BuildOptions.BinCacheSource
         GlobalData.gEnableGenfdsMultiThread = not BuildOptions.NoGenfdsMultiThread
+        GlobalData.gGenFdsCacheDir = BuildOptions.GenFdsCacheDir
         GlobalData.gDisableIncludePathCheck = BuildOptions.DisableIncludePathCheck
 
         if GlobalData.gBinCacheDest and not GlobalData.gUseHashCache:
@@ -727,6 +728,9 @@ class Build():
         if GlobalData.gBinCacheSource and not GlobalData.gUseHashCache:
             EdkLogger.error("build", OPTION_NOT_SUPPORTED, ExtraData="--binary-source must be used together with --hash.")
 
+        if GlobalData.gGenFdsCacheDir and GlobalData.gEnableGenfdsMultiThread:
+            EdkLogger.error("build", OPTION_NOT_SUPPORTED, ExtraData="--genfds-cache must be used together with --no-genfds-multi-thread.")
+
         if GlobalData.gBinCacheDest and GlobalData.gBinCacheSource:
             EdkLogger.error("build", OPTION_NOT_SUPPORTED, ExtraData="--binary-destination can not be used together with --binary-source.")
 
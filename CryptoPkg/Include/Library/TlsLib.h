@@ -439,7 +439,10 @@ TlsSetVerifyHost (
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
   This function sets a session ID to be used when the TLS/SSL connection is
-  to be established.
+  to be established. If a session with this ID was established earlier by a
+  connection of this module to the same server name, see TlsSetVerifyHost(),
+  and can still be resumed, the connection resumes it instead of doing a full
+  handshake.
 
   @param[in]  Tls             Pointer to the TLS object.
   @param[in]  SessionId       Session ID data used for session resumption.
@@ -41,4 +41,61 @@ typedef struct {
   BIO    *OutBio;
 } TLS_CONNECTION;
 
+//
+// Number of client sessions kept for resumption.
+//
+#define TLS_SESSION_CACHE_SIZE  8
+
+/**
+  New session callback of the SSL_CTX objects.
+
+  Called by OpenSSL when a connection gets a new session, after a full
+  handshake or when a session ticket is received. Only the sessions of client
+  connections with a server name are cached.
+
+  @param[in]  Ssl         The SSL connection.
+  @param[in]  Session     The new session.
+
+  @retval  1     The session is cached, the reference to it is kept.
+  @retval  0     The session is not cached.
+
+**/
+int
+TlsSessionCacheNew (
+  IN     SSL          *Ssl,
+  IN     SSL_SESSION  *Session
+  );
+
+/**
+  Look up a cached session by its session ID, for a connection.
+
+  The session is only returned if it was established with the server name that
+  is set on the connection.
+
+  @param[in]  TlsConn         The TLS connection that is to resume the session.
+  @param[in]  SessionId       Session ID.
+  @param[in]  SessionIdLen    Length of Session ID in bytes.
+
+  @return  The session, still owned by the cache, or NULL if no resumable
+           session of this server has this ID.
+
+**/
+SSL_SESSION *
+TlsSessionCacheLookup (
+  IN     TLS_CONNECTION  *TlsConn,
+  IN     CONST UINT8     *SessionId,
+  IN     UINT16          SessionIdLen
+  );
+
+/**
+  Count a completed handshake as full or resumed, and report the statistics.
+
+  @param[in]  TlsConn     The TLS connection that completed the handshake.
+
+**/
+VOID
+TlsSessionCacheRecordHandshake (
+  IN     TLS_CONNECTION  *TlsConn
+  );
+
 #endif
@@ -556,7 +556,10 @@ TlsSetVerifyHost (
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
   This function sets a session ID to be used when the TLS/SSL connection is
-  to be established.
+  to be established. If a session with this ID was established earlier by a
+  connection of this module to the same server name, see TlsSetVerifyHost(),
+  and can still be resumed, the connection resumes it instead of doing a full
+  handshake.
 
   @param[in]  Tls             Pointer to the TLS object.
   @param[in]  SessionId       Session ID data used for session resumption.
@@ -585,6 +588,15 @@ TlsSetSessionId (
     return EFI_INVALID_PARAMETER;
   }
 
+  Session = TlsSessionCacheLookup (TlsConn, SessionId, SessionIdLen);
+  if (Session != NULL) {
+    if (SSL_set_session (TlsConn->Ssl, Session) != 1) {
+      return EFI_UNSUPPORTED;
+    }
+
+    return EFI_SUCCESS;
+  }
+
   Session = SSL_get_session (TlsConn->Ssl);
   if (Session == NULL) {
     return EFI_UNSUPPORTED;
@@ -106,6 +106,14 @@ TlsCtxNew (
   //
   SSL_CTX_set_min_proto_version (TlsCtx, ProtoVersion);
 
+  //
+  // Keep the client sessions in the session cache of TlsLib, so that a later
+  // connection can resume one through TlsSetSessionId(). The server sessions
+  // stay in the internal session cache of the SSL_CTX.
+  //
+  SSL_CTX_set_session_cache_mode (TlsCtx, SSL_SESS_CACHE_BOTH);
+  SSL_CTX_sess_set_new_cb (TlsCtx, TlsSessionCacheNew);
+
   return (VOID *)TlsCtx;
 }
 
@@ -81,10 +81,12 @@ TlsDoHandshake (
   TLS_CONNECTION  *TlsConn;
   UINTN           PendingBufferSize;
   INTN            Ret;
+  BOOLEAN         Finished;
 
   TlsConn           = (TLS_CONNECTION *)Tls;
   PendingBufferSize = 0;
   Ret               = 1;
+  Finished          = FALSE;
 
   if ((TlsConn == NULL) || \
       (TlsConn->Ssl == NULL) || (TlsConn->InBio == NULL) || (TlsConn->OutBio == NULL) || \
@@ -106,6 +108,7 @@ TlsDoHandshake (
     if (PendingBufferSize == 0) {
       SSL_set_connect_state (TlsConn->Ssl);
       Ret               = SSL_do_handshake (TlsConn->Ssl);
+      Finished          = (BOOLEAN)(Ret == 1);
       PendingBufferSize = (UINTN)BIO_ctrl_pending (TlsConn->OutBio);
     }
   } else {
@@ -113,6 +116,7 @@ TlsDoHandshake (
     if (PendingBufferSize == 0) {
       BIO_write (TlsConn->InBio, BufferIn, (UINT32)BufferInSize);
       Ret               = SSL_do_handshake (TlsConn->Ssl);
+      Finished          = (BOOLEAN)(Ret == 1);
       PendingBufferSize = (UINTN)BIO_ctrl_pending (TlsConn->OutBio);
     }
   }
@@ -158,6 +162,10 @@ TlsDoHandshake (
     }
   }
 
+  if (Finished) {
+    TlsSessionCacheRecordHandshake (TlsConn);
+  }
+
   if (PendingBufferSize > *BufferOutSize) {
     *BufferOutSize = PendingBufferSize;
     return EFI_BUFFER_TOO_SMALL;
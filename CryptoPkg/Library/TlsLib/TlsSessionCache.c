@@ -0,0 +1,273 @@
+/** @file
+  Client session cache for TLS session resumption.
+
+  The sessions established by the TLS client connections are kept for the life
+  of the module, and are looked up by their session ID when a connection is
+  asked to resume one. A session received in a session ticket gets the SHA-256
+  hash of the ticket as session ID, so the same lookup serves both kinds of
+  resumption.
+
+  A TLS 1.2 session ID is chosen by the server and sent in the clear, so any
+  server can hand out the session ID of a session of another server. Each
+  session is therefore bound to the server name (SNI) of the connection that
+  established it, and is only resumed by a connection to the same server name.
+  A session never replaces a cached session that has the same session ID.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalTlsLib.h"
+
+typedef struct {
+  SSL_SESSION    *Session;
+  //
+  // Server name of the connection that established the session.
+  //
+  CHAR8          *ServerName;
+} TLS_SESSION_CACHE_ENTRY;
+
+//
+// The cached sessions, the least recently used first.
+//
+STATIC TLS_SESSION_CACHE_ENTRY  mTlsSessionCache[TLS_SESSION_CACHE_SIZE];
+STATIC UINTN                    mTlsSessionCacheCount;
+
+STATIC UINTN  mTlsSessionCacheLookups;
+STATIC UINTN  mTlsSessionCacheHits;
+STATIC UINTN  mTlsFullHandshakes;
+STATIC UINTN  mTlsResumedHandshakes;
+
+/**
+  Remove one session from the cache, without freeing it.
+
+  @param[in]  Index       Index of the session in the cache.
+  @param[out] Entry       The removed entry.
+
+**/
+STATIC
+VOID
+TlsSessionCacheRemove (
+  IN     UINTN                    Index,
+  OUT    TLS_SESSION_CACHE_ENTRY  *Entry
+  )
+{
+  ASSERT (Index < mTlsSessionCacheCount);
+
+  CopyMem (Entry, &mTlsSessionCache[Index], sizeof (TLS_SESSION_CACHE_ENTRY));
+  mTlsSessionCacheCount--;
+  CopyMem (
+    &mTlsSessionCache[Index],
+    &mTlsSessionCache[Index + 1],
+    (mTlsSessionCacheCount - Index) * sizeof (TLS_SESSION_CACHE_ENTRY)
+    );
+  ZeroMem (&mTlsSessionCache[mTlsSessionCacheCount], sizeof (TLS_SESSION_CACHE_ENTRY));
+}
+
+/**
+  Remove one session from the cache and free it.
+
+  @param[in]  Index       Index of the session in the cache.
+
+**/
+STATIC
+VOID
+TlsSessionCacheDelete (
+  IN     UINTN  Index
+  )
+{
+  TLS_SESSION_CACHE_ENTRY  Entry;
+
+  TlsSessionCacheRemove (Index, &Entry);
+  SSL_SESSION_free (Entry.Session);
+  FreePool (Entry.ServerName);
+}
+
+/**
+  Find a session in the cache by its session ID.
+
+  @param[in]  SessionId       Session ID.
+  @param[in]  SessionIdLen    Length of Session ID in bytes.
+
+  @return  Index of the session, or TLS_SESSION_CACHE_SIZE if it is not cached.
+
+**/
+STATIC
+UINTN
+TlsSessionCacheFind (
+  IN     CONST UINT8  *SessionId,
+  IN     UINT32       SessionIdLen
+  )
+{
+  UINTN        Index;
+  CONST UINT8  *CachedId;
+  UINT32       CachedIdLen;
+
+  for (Index = 0; Index < mTlsSessionCacheCount; Index++) {
+    CachedId = SSL_SESSION_get_id (mTlsSessionCache[Index].Session, &CachedIdLen);
+    if ((CachedIdLen == SessionIdLen) && (CompareMem (CachedId, SessionId, SessionIdLen) == 0)) {
+      return Index;
+    }
+  }
+
+  return TLS_SESSION_CACHE_SIZE;
+}
+
+/**
+  New session callback of the SSL_CTX objects.
+
+  Called by OpenSSL when a connection gets a new session, after a full
+  handshake or when a session ticket is received. Only the sessions of client
+  connections with a server name are cached.
+
+  @param[in]  Ssl         The SSL connection.
+  @param[in]  Session     The new session.
+
+  @retval  1     The session is cached, the reference to it is kept.
+  @retval  0     The session is not cached.
+
+**/
+int
+TlsSessionCacheNew (
+  IN     SSL          *Ssl,
+  IN     SSL_SESSION  *Session
+  )
+{
+  CONST UINT8  *SessionId;
+  UINT32       SessionIdLen;
+  CONST CHAR8  *ServerName;
+  CHAR8        *CachedServerName;
+
+  if (SSL_is_server (Ssl)) {
+    return 0;
+  }
+
+  ServerName = SSL_get_servername (Ssl, TLSEXT_NAMETYPE_host_name);
+  if ((ServerName == NULL) || (*ServerName == '\0')) {
+    return 0;
+  }
+
+  SessionId = SSL_SESSION_get_id (Session, &SessionIdLen);
+  if ((SessionIdLen == 0) || !SSL_SESSION_is_resumable (Session)) {
+    return 0;
+  }
+
+  //
+  // Keep the cached session, so that a server cannot take over the session ID
+  // of a session of another server.
+  //
+  if (TlsSessionCacheFind (SessionId, SessionIdLen) != TLS_SESSION_CACHE_SIZE) {
+    DEBUG ((DEBUG_WARN, "%a: Session ID of %a is already cached, not caching it\n", __func__, ServerName));
+    return 0;
+  }
+
+  CachedServerName = AllocateCopyPool (AsciiStrSize (ServerName), ServerName);
+  if (CachedServerName == NULL) {
+    return 0;
+  }
+
+  if (mTlsSessionCacheCount == TLS_SESSION_CACHE_SIZE) {
+    TlsSessionCacheDelete (0);
+  }
+
+  mTlsSessionCache[mTlsSessionCacheCount].Session    = Session;
+  mTlsSessionCache[mTlsSessionCacheCount].ServerName = CachedServerName;
+  mTlsSessionCacheCount++;
+  return 1;
+}
+
+/**
+  Look up a cached session by its session ID, for a connection.
+
+  The session is only returned if it was established with the server name that
+  is set on the connection.
+
+  @param[in]  TlsConn         The TLS connection that is to resume the session.
+  @param[in]  SessionId       Session ID.
+  @param[in]  SessionIdLen    Length of Session ID in bytes.
+
+  @return  The session, still owned by the cache, or NULL if no resumable
+           session of this server has this ID.
+
+**/
+SSL_SESSION *
+TlsSessionCacheLookup (
+  IN     TLS_CONNECTION  *TlsConn,
+  IN     CONST UINT8     *SessionId,
+  IN     UINT16          SessionIdLen
+  )
+{
+  UINTN                    Index;
+  CONST CHAR8              *ServerName;
+  CONST CHAR8              *SessionServerName;
+  TLS_SESSION_CACHE_ENTRY  Entry;
+
+  mTlsSessionCacheLookups++;
+
+  ServerName = SSL_get_servername (TlsConn->Ssl, TLSEXT_NAMETYPE_host_name);
+  if (ServerName == NULL) {
+    return NULL;
+  }
+
+  Index = TlsSessionCacheFind (SessionId, SessionIdLen);
+  if (Index == TLS_SESSION_CACHE_SIZE) {
+    return NULL;
+  }
+
+  //
+  // The session must have been established with the server this connection
+  // is going to verify, both according to the cache and to the session.
+  //
+  SessionServerName = SSL_SESSION_get0_hostname (mTlsSessionCache[Index].Session);
+  if ((AsciiStriCmp (mTlsSessionCache[Index].ServerName, ServerName) != 0) ||
+      ((SessionServerName != NULL) && (AsciiStriCmp (SessionServerName, ServerName) != 0)))
+  {
+    DEBUG ((DEBUG_WARN, "%a: Session ID was not established with %a, not resuming it\n", __func__, ServerName));
+    return NULL;
+  }
+
+  if (!SSL_SESSION_is_resumable (mTlsSessionCache[Index].Session)) {
+    TlsSessionCacheDelete (Index);
+    return NULL;
+  }
+
+  //
+  // Move the session to the most recently used end.
+  //
+  TlsSessionCacheRemove (Index, &Entry);
+  CopyMem (&mTlsSessionCache[mTlsSessionCacheCount++], &Entry, sizeof (TLS_SESSION_CACHE_ENTRY));
+  mTlsSessionCacheHits++;
+
+  return Entry.Session;
+}
+
+/**
+  Count a completed handshake as full or resumed, and report the statistics.
+
+  @param[in]  TlsConn     The TLS connection that completed the handshake.
+
+**/
+VOID
+TlsSessionCacheRecordHandshake (
+  IN     TLS_CONNECTION  *TlsConn
+  )
+{
+  if (SSL_session_reused (TlsConn->Ssl)) {
+    mTlsResumedHandshakes++;
+  } else {
+    mTlsFullHandshakes++;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "%a: %a handshake, full %d, resumed %d, cache lookups %d, hits %d, sessions %d\n",
+    __func__,
+    SSL_session_reused (TlsConn->Ssl) ? "Resumed" : "Full",
+    mTlsFullHandshakes,
+    mTlsResumedHandshakes,
+    mTlsSessionCacheLookups,
+    mTlsSessionCacheHits,
+    mTlsSessionCacheCount
+    ));
+}
@@ -0,0 +1,445 @@
+/** @file
+  Shell application to dump event notify profile information.
+
+  The notification functions are grouped by the image that contains them.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/DebugLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/PeCoffGetEntryPointLib.h>
+#include <Library/PrintLib.h>
+
+#include <Protocol/LoadedImage.h>
+#include <Protocol/EventNotifyProfile.h>
+
+#define PROFILE_NAME_STRING_LENGTH  64
+
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    ImageBase;
+  UINT64                  ImageSize;
+  CHAR8                   Name[PROFILE_NAME_STRING_LENGTH + 1];
+  UINT64                  TotalTime;
+} PROFILE_IMAGE_INFO;
+
+/**
+  Get the file name portion of the Pdb File Name.
+
+  The portion of the Pdb File Name between the last backslash and
+  either a following period or the end of the string is copied into
+  AsciiBuffer.  The name is truncated, if necessary, to ensure that
+  AsciiBuffer is not overrun.
+
+  @param[in]  PdbFileName     Pdb file name.
+  @param[out] AsciiBuffer     The resultant Ascii File Name.
+
+**/
+VOID
+GetShortPdbFileName (
+  IN  CHAR8  *PdbFileName,
+  OUT CHAR8  *AsciiBuffer
+  )
+{
+  UINTN  IndexPdb;    // Current work location within a Pdb string.
+  UINTN  IndexBuffer; // Current work location within a Buffer string.
+  UINTN  StartIndex;
+  UINTN  EndIndex;
+
+  ZeroMem (AsciiBuffer, PROFILE_NAME_STRING_LENGTH + 1);
+
+  StartIndex = 0;
+  for (EndIndex = 0; PdbFileName[EndIndex] != 0; EndIndex++) {
+  }
+
+  for (IndexPdb = 0; PdbFileName[IndexPdb] != 0; IndexPdb++) {
+    if ((PdbFileName[IndexPdb] == '\\') || (PdbFileName[IndexPdb] == '/')) {
+      StartIndex = IndexPdb + 1;
+    }
+
+    if (PdbFileName[IndexPdb] == '.') {
+      EndIndex = IndexPdb;
+    }
+  }
+
+  IndexBuffer = 0;
+  for (IndexPdb = StartIndex; IndexPdb < EndIndex; IndexPdb++) {
+    AsciiBuffer[IndexBuffer] = PdbFileName[IndexPdb];
+    IndexBuffer++;
+    if (IndexBuffer >= PROFILE_NAME_STRING_LENGTH) {
+      AsciiBuffer[PROFILE_NAME_STRING_LENGTH] = 0;
+      break;
+    }
+  }
+}
+
+/**
+  Get a human readable name for an image.
+  The following methods will be tried orderly:
+    1. Image PDB
+    2. Image GUID
+    3. Image base
+
+  @param[in]  LoadedImage  Pointer to the loaded image protocol of the image.
+  @param[out] Name         The resulting Ascii name string.
+
+**/
+VOID
+GetImageName (
+  IN  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage,
+  OUT CHAR8                      *Name
+  )
+{
+  CHAR8     *PdbFileName;
+  EFI_GUID  *FileName;
+
+  PdbFileName = PeCoffLoaderGetPdbPointer (LoadedImage->ImageBase);
+  if (PdbFileName != NULL) {
+    GetShortPdbFileName (PdbFileName, Name);
+    return;
+  }
+
+  FileName = NULL;
+  if (LoadedImage->FilePath != NULL) {
+    FileName = EfiGetNameGuidFromFwVolDevicePathNode ((MEDIA_FW_VOL_FILEPATH_DEVICE_PATH *)LoadedImage->FilePath);
+  }
+
+  if (FileName != NULL) {
+    AsciiSPrint (Name, PROFILE_NAME_STRING_LENGTH + 1, "%g", FileName);
+  } else {
+    AsciiSPrint (Name, PROFILE_NAME_STRING_LENGTH + 1, "Image@0x%lx", (UINT64)(UINTN)LoadedImage->ImageBase);
+  }
+}
+
+/**
+  Collect the loaded images, so notification functions can be mapped to them.
+
+  @param[out] ImageCount  The number of images returned.
+
+  @return The image info array, with one extra entry for unknown images, or NULL.
+
+**/
+PROFILE_IMAGE_INFO *
+CollectImageInfo (
+  OUT UINTN  *ImageCount
+  )
+{
+  EFI_STATUS                 Status;
+  EFI_HANDLE                 *HandleBuffer;
+  UINTN                      HandleCount;
+  UINTN                      Index;
+  UINTN                      Count;
+  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage;
+  PROFILE_IMAGE_INFO         *ImageInfo;
+
+  HandleBuffer = NULL;
+  HandleCount  = 0;
+  Status       = gBS->LocateHandleBuffer (
+                        ByProtocol,
+                        &gEfiLoadedImageProtocolGuid,
+                        NULL,
+                        &HandleCount,
+                        &HandleBuffer
+                        );
+  if (EFI_ERROR (Status)) {
+    HandleCount = 0;
+  }
+
+  ImageInfo = AllocateZeroPool ((HandleCount + 1) * sizeof (PROFILE_IMAGE_INFO));
+  if (ImageInfo == NULL) {
+    if (HandleBuffer != NULL) {
+      FreePool (HandleBuffer);
+    }
+
+    return NULL;
+  }
+
+  Count = 0;
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (HandleBuffer[Index], &gEfiLoadedImageProtocolGuid, (VOID **)&LoadedImage);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    ImageInfo[Count].ImageBase = (EFI_PHYSICAL_ADDRESS)(UINTN)LoadedImage->ImageBase;
+    ImageInfo[Count].ImageSize = LoadedImage->ImageSize;
+    GetImageName (LoadedImage, ImageInfo[Count].Name);
+    Count++;
+  }
+
+  AsciiStrCpyS (ImageInfo[Count].Name, PROFILE_NAME_STRING_LENGTH + 1, "Unknown");
+
+  if (HandleBuffer != NULL) {
+    FreePool (HandleBuffer);
+  }
+
+  *ImageCount = Count;
+  return ImageInfo;
+}
+
+/**
+  Find the image that contains the address.
+
+  @param[in] ImageInfo   The image info array.
+  @param[in] ImageCount  The number of images, not counting the entry for unknown images.
+  @param[in] Address     The address.
+
+  @return The index of the image, or ImageCount if no image contains the address.
+
+**/
+UINTN
+FindImageByAddress (
+  IN PROFILE_IMAGE_INFO    *ImageInfo,
+  IN UINTN                 ImageCount,
+  IN EFI_PHYSICAL_ADDRESS  Address
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ImageCount; Index++) {
+    if ((Address >= ImageInfo[Index].ImageBase) &&
+        (Address < ImageInfo[Index].ImageBase + ImageInfo[Index].ImageSize))
+    {
+      break;
+    }
+  }
+
+  return Index;
+}
+
+/**
+  Convert a TPL to a string.
+
+  @param[in] Tpl  The TPL.
+
+  @return Pointer to string.
+
+**/
+CHAR16 *
+TplToStr (
+  IN UINT64  Tpl
+  )
+{
+  switch (Tpl) {
+    case TPL_APPLICATION:
+      return L"APPLICATION";
+    case TPL_CALLBACK:
+      return L"CALLBACK";
+    case TPL_NOTIFY:
+      return L"NOTIFY";
+    case TPL_HIGH_LEVEL - 1:
+      return L"HIGH_LEVEL-1";
+    default:
+      return L"";
+  }
+}
+
+/**
+  Check whether a record is reported before another one.
+
+  Records are grouped by image, images with more total time first, and records
+  with more total time come first within an image.
+
+  @param[in] ImageInfo   The image info array.
+  @param[in] ImageIndex  The image index of each record.
+  @param[in] Records     The event notify profile records.
+  @param[in] Index1      The index of the first record.
+  @param[in] Index2      The index of the second record.
+
+  @retval TRUE   The first record is reported before the second one.
+  @retval FALSE  The first record is not reported before the second one.
+
+**/
+BOOLEAN
+IsRecordBefore (
+  IN PROFILE_IMAGE_INFO                 *ImageInfo,
+  IN UINTN                              *ImageIndex,
+  IN EDKII_EVENT_NOTIFY_PROFILE_RECORD  *Records,
+  IN UINTN                              Index1,
+  IN UINTN                              Index2
+  )
+{
+  if (ImageInfo[ImageIndex[Index1]].TotalTime != ImageInfo[ImageIndex[Index2]].TotalTime) {
+    return (BOOLEAN)(ImageInfo[ImageIndex[Index1]].TotalTime > ImageInfo[ImageIndex[Index2]].TotalTime);
+  }
+
+  if (ImageIndex[Index1] != ImageIndex[Index2]) {
+    return (BOOLEAN)(ImageIndex[Index1] < ImageIndex[Index2]);
+  }
+
+  return (BOOLEAN)(Records[Index1].TotalTime > Records[Index2].TotalTime);
+}
+
+/**
+  Dump the event notify profile, grouped by image.
+
+  @param[in] Records       The event notify profile records.
+  @param[in] RecordCount   The number of records.
+  @param[in] DroppedCount  The number of dispatches that were not recorded.
+
+**/
+VOID
+DumpEventNotifyProfile (
+  IN EDKII_EVENT_NOTIFY_PROFILE_RECORD  *Records,
+  IN UINTN                              RecordCount,
+  IN UINT64                             DroppedCount
+  )
+{
+  PROFILE_IMAGE_INFO                 *ImageInfo;
+  UINTN                              ImageCount;
+  UINTN                              *ImageIndex;
+  UINTN                              Index;
+  UINTN                              Index2;
+  EDKII_EVENT_NOTIFY_PROFILE_RECORD  Record;
+  UINTN                              Temp;
+
+  ImageInfo = CollectImageInfo (&ImageCount);
+  if (ImageInfo == NULL) {
+    Print (L"EventNotifyProfileInfo: Out of resources\n");
+    return;
+  }
+
+  ImageIndex = AllocateZeroPool (RecordCount * sizeof (UINTN));
+  if (ImageIndex == NULL) {
+    Print (L"EventNotifyProfileInfo: Out of resources\n");
+    FreePool (ImageInfo);
+    return;
+  }
+
+  for (Index = 0; Index < RecordCount; Index++) {
+    ImageIndex[Index]                       = FindImageByAddress (ImageInfo, ImageCount, Records[Index].NotifyFunction);
+    ImageInfo[ImageIndex[Index]].TotalTime += Records[Index].TotalTime;
+  }
+
+  //
+  // Sort the records by the total time of their image, then by their own total time.
+  //
+  for (Index = 1; Index < RecordCount; Index++) {
+    for (Index2 = Index; Index2 > 0; Index2--) {
+      if (!IsRecordBefore (ImageInfo, ImageIndex, Records, Index2, Index2 - 1)) {
+        break;
+      }
+
+      CopyMem (&Record, &Records[Index2], sizeof (Record));
+      CopyMem (&Records[Index2], &Records[Index2 - 1], sizeof (Record));
+      CopyMem (&Records[Index2 - 1], &Record, sizeof (Record));
+      Temp                   = ImageIndex[Index2];
+      ImageIndex[Index2]     = ImageIndex[Index2 - 1];
+      ImageIndex[Index2 - 1] = Temp;
+    }
+  }
+
+  Print (L"Event notify profile (times in us):\n");
+  for (Index = 0; Index < RecordCount; Index++) {
+    if ((Index == 0) || (ImageIndex[Index] != ImageIndex[Index - 1])) {
+      Print (
+        L"\n%a (Total %ld us)\n",
+        ImageInfo[ImageIndex[Index]].Name,
+        DivU64x32 (ImageInfo[ImageIndex[Index]].TotalTime, 10)
+        );
+      Print (L"  NotifyFunction      TPL           Dispatches   TotalTime     MaxTime  AvgLatency  MaxLatency\n");
+    }
+
+    Print (L"  ");
+    if (ImageIndex[Index] < ImageCount) {
+      Print (L"+0x%-16lx", Records[Index].NotifyFunction - ImageInfo[ImageIndex[Index]].ImageBase);
+    } else {
+      Print (L"0x%-17lx", Records[Index].NotifyFunction);
+    }
+
+    Print (
+      L" %-12s %10ld %11ld %11ld",
+      TplToStr (Records[Index].NotifyTpl),
+      Records[Index].DispatchCount,
+      DivU64x32 (Records[Index].TotalTime, 10),
+      DivU64x32 (Records[Index].MaxTime, 10)
+      );
+    if (Records[Index].ExpiredCount != 0) {
+      Print (
+        L" %11ld %11ld",
+        DivU64x32 (DivU64x64Remainder (Records[Index].TotalLatency, Records[Index].ExpiredCount, NULL), 10),
+        DivU64x32 (Records[Index].MaxLatency, 10)
+        );
+    }
+
+    Print (L"\n");
+  }
+
+  if (DroppedCount != 0) {
+    Print (L"\n%ld dispatches were not recorded because the profile is full\n", DroppedCount);
+  }
+
+  FreePool (ImageIndex);
+  FreePool (ImageInfo);
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the image goes into a library that calls this function.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+EventNotifyProfileInfoEntrypoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                           Status;
+  EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *Profile;
+  EDKII_EVENT_NOTIFY_PROFILE_RECORD    *Records;
+  UINTN                                RecordCount;
+  UINT64                               DroppedCount;
+
+  Status = gBS->LocateProtocol (&gEdkiiEventNotifyProfileProtocolGuid, NULL, (VOID **)&Profile);
+  if (EFI_ERROR (Status)) {
+    Print (L"EventNotifyProfileInfo: Locate EventNotifyProfile protocol - %r\n", Status);
+    return Status;
+  }
+
+  Records      = NULL;
+  RecordCount  = 0;
+  DroppedCount = 0;
+  Status       = Profile->GetData (Profile, &RecordCount, NULL, &DroppedCount);
+  while (Status == EFI_BUFFER_TOO_SMALL) {
+    if (Records != NULL) {
+      FreePool (Records);
+    }
+
+    Records = AllocatePool (RecordCount * sizeof (EDKII_EVENT_NOTIFY_PROFILE_RECORD));
+    if (Records == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Status = Profile->GetData (Profile, &RecordCount, Records, &DroppedCount);
+  }
+
+  if (EFI_ERROR (Status)) {
+    Print (L"EventNotifyProfileInfo: GetData - %r\n", Status);
+  } else if (RecordCount == 0) {
+    Print (L"EventNotifyProfileInfo: No event notification recorded\n");
+  } else {
+    DumpEventNotifyProfile (Records, RecordCount, DroppedCount);
+  }
+
+  if (Records != NULL) {
+    FreePool (Records);
+  }
+
+  return Status;
+}
@@ -46,6 +46,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SmmBase2.h>
 #include <Protocol/PeCoffImageEmulator.h>
 #include <Protocol/MemoryAttribute.h>
+#include <Protocol/EventNotifyProfile.h>
 #include <Guid/MemoryTypeInformation.h>
 #include <Guid/FirmwareFileSystem2.h>
 #include <Guid/FirmwareFileSystem3.h>
@@ -70,6 +71,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseLib.h>
 #include <Library/HobLib.h>
 #include <Library/PerformanceLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiDecompressLib.h>
 #include <Library/ExtractGuidedSectionLib.h>
 #include <Library/CacheMaintenanceLib.h>
@@ -441,6 +443,17 @@ CoreTimerTick (
   IN UINT64  Duration
   );
 
+/**
+  Dumps the timer statistics to the debug output.
+
+  All times are printed in units of 100ns.
+
+**/
+VOID
+CoreDumpTimerStatistics (
+  VOID
+  );
+
 /**
   Initialize the dispatcher. Initialize the notification function that runs when
   an FV2 protocol is added to the system.
@@ -2588,6 +2601,15 @@ MemoryProfileInstallProtocol (
   VOID
   );
 
+/**
+  Install event notify profile protocol.
+
+**/
+VOID
+EventNotifyProfileInstallProtocol (
+  VOID
+  );
+
 /**
   Register image to memory profile.
 
@@ -469,6 +469,7 @@ DxeMain (
   InitializeDebugAgent (DEBUG_AGENT_INIT_DXE_CORE_LATE, HobStart, NULL);
 
   MemoryProfileInstallProtocol ();
+  EventNotifyProfileInstallProtocol ();
 
   CoreInitializeMemoryAttributesTable ();
   CoreInitializeMemoryProtection ();
@@ -787,6 +788,7 @@ CoreExitBootServices (
   //
   if (!mExitBootServicesCalled) {
     CoreNotifySignalList (&gEfiEventBeforeExitBootServicesGuid);
+    CoreDumpTimerStatistics ();
     mExitBootServicesCalled = TRUE;
   }
 
@@ -153,8 +153,15 @@ CoreDispatchEventNotifies (
   IN EFI_TPL  Priority
   )
 {
-  IEVENT      *Event;
-  LIST_ENTRY  *Head;
+  IEVENT            *Event;
+  LIST_ENTRY        *Head;
+  EFI_EVENT_NOTIFY  NotifyFunction;
+  UINT32            EventType;
+  BOOLEAN           Profile;
+  BOOLEAN           Expired;
+  UINT64            DueTime;
+  UINT64            Latency;
+  UINT64            StartTime;
 
   CoreAcquireEventLock ();
   ASSERT (gEventQueueLock.OwnerTpl == Priority);
@@ -177,13 +184,44 @@ CoreDispatchEventNotifies (
       Event->SignalCount = 0;
     }
 
+    Expired = FALSE;
+    DueTime = 0;
+    Profile = FeaturePcdGet (PcdDxeCoreEventNotifyProfileEnable) ||
+              (FeaturePcdGet (PcdDxeCoreTimerStatisticsEnable) && ((Event->Type & EVT_TIMER) != 0));
+    if (Profile) {
+      //
+      // Only a dispatch caused by the expiration of the timer has a latency,
+      // not one of a timer event that was signaled with SignalEvent().
+      //
+      Expired              = Event->Timer.Expired;
+      DueTime              = Event->Timer.DueTime;
+      Event->Timer.Expired = FALSE;
+    }
+
     CoreReleaseEventLock ();
 
     //
     // Notify this event
     //
     ASSERT (Event->NotifyFunction != NULL);
-    Event->NotifyFunction (Event, Event->NotifyContext);
+    if (Profile) {
+      //
+      // The notification function may close the event, so do not touch it afterwards.
+      //
+      NotifyFunction = Event->NotifyFunction;
+      EventType      = Event->Type;
+      Latency        = 0;
+      if (Expired) {
+        Latency = CoreCurrentSystemTime ();
+        Latency = (Latency > DueTime) ? Latency - DueTime : 0;
+      }
+
+      StartTime = GetPerformanceCounter ();
+      NotifyFunction (Event, Event->NotifyContext);
+      CoreRecordEventNotify (NotifyFunction, Priority, EventType, Expired, Latency, StartTime, GetPerformanceCounter ());
+    } else {
+      Event->NotifyFunction (Event, Event->NotifyContext);
+    }
 
     //
     // Check for next pending event
@@ -33,8 +33,26 @@ typedef struct {
   LIST_ENTRY    Link;
   UINT64        TriggerTime;
   UINT64        Period;
+  ///
+  /// The trigger time the event was last signaled for by the timer, used by
+  /// timer statistics and the event notify profile
+  ///
+  UINT64        DueTime;
+  ///
+  /// TRUE if the timer expired and the notification function has not been
+  /// dispatched since. Set when the timer expires, cleared on dispatch.
+  ///
+  BOOLEAN       Expired;
 } TIMER_EVENT_INFO;
 
+///
+/// Maximum number of notification function and TPL pairs in the event notify profile
+///
+#define EVENT_NOTIFY_PROFILE_MAX  256
+
+extern EDKII_EVENT_NOTIFY_PROFILE_RECORD  mEventNotifyProfile[EVENT_NOTIFY_PROFILE_MAX];
+extern UINT64                             mEventNotifyProfileDropped;
+
 #define EVENT_SIGNATURE  SIGNATURE_32('e','v','n','t')
 typedef struct {
   UINTN                      Signature;
@@ -76,6 +94,17 @@ CoreDispatchEventNotifies (
   IN EFI_TPL  Priority
   );
 
+/**
+  Returns the current system time.
+
+  @return The current system time
+
+**/
+UINT64
+CoreCurrentSystemTime (
+  VOID
+  );
+
 /**
   Initializes timer support.
 
@@ -85,4 +114,28 @@ CoreInitializeTimer (
   VOID
   );
 
+/**
+  Records the dispatch of an event notification function.
+
+  @param  NotifyFunction         The notification function of the event.
+  @param  NotifyTpl              The TPL the notification function ran at.
+  @param  EventType              The type of the event.
+  @param  Expired                TRUE if the dispatch was caused by the expiration of the timer of the event.
+  @param  Latency                The system time from the expiration of the timer to the dispatch.
+                                 Ignored if Expired is FALSE.
+  @param  StartTime              The performance counter when the notification function was called.
+  @param  EndTime                The performance counter when the notification function returned.
+
+**/
+VOID
+CoreRecordEventNotify (
+  IN EFI_EVENT_NOTIFY  NotifyFunction,
+  IN EFI_TPL           NotifyTpl,
+  IN UINT32            EventType,
+  IN BOOLEAN           Expired,
+  IN UINT64            Latency,
+  IN UINT64            StartTime,
+  IN UINT64            EndTime
+  );
+
 #endif
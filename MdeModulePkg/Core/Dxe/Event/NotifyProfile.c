@@ -0,0 +1,288 @@
+/** @file
+  Event notify profile support.
+
+  Records the number of dispatches, the time spent and, for timer events, the
+  dispatch latency of each notification function at each TPL.
+  The time spent is measured with the performance counter of TimerLib.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeMain.h"
+#include "Event.h"
+
+/**
+  Get the event notify profile.
+
+  @param[in]      This          The EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL instance.
+  @param[in, out] RecordCount   On input, the number of records the Records buffer can hold.
+                                On output, the number of records returned, or the number
+                                of records required if EFI_BUFFER_TOO_SMALL is returned.
+  @param[out]     Records       The buffer to return the records in.
+  @param[out]     DroppedCount  The number of dispatches that were not recorded because
+                                the profile was full. Optional.
+
+  @retval EFI_SUCCESS           The profile is returned.
+  @retval EFI_INVALID_PARAMETER RecordCount is NULL, or Records is NULL and *RecordCount is not 0.
+  @retval EFI_BUFFER_TOO_SMALL  The Records buffer is too small. *RecordCount is updated.
+
+**/
+EFI_STATUS
+EFIAPI
+EventNotifyProfileGetData (
+  IN     EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *This,
+  IN OUT UINTN                                *RecordCount,
+  OUT    EDKII_EVENT_NOTIFY_PROFILE_RECORD    *Records,
+  OUT    UINT64                               *DroppedCount OPTIONAL
+  );
+
+/**
+  Clear the event notify profile.
+
+  @param[in] This  The EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The profile is cleared.
+
+**/
+EFI_STATUS
+EFIAPI
+EventNotifyProfileReset (
+  IN EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *This
+  );
+
+EFI_LOCK                           mEventNotifyProfileLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL - 1);
+EDKII_EVENT_NOTIFY_PROFILE_RECORD  mEventNotifyProfile[EVENT_NOTIFY_PROFILE_MAX];
+UINT64                             mEventNotifyProfileDropped = 0;
+
+EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  mEventNotifyProfileProtocol = {
+  EventNotifyProfileGetData,
+  EventNotifyProfileReset
+};
+
+//
+// Start and end values of the performance counter, read on the first dispatch
+//
+UINT64  mEventNotifyCounterStart = 0;
+UINT64  mEventNotifyCounterEnd   = 0;
+
+/**
+  Converts the performance counter values taken around a notification function
+  to the time spent, in units of 100ns.
+
+  @param  StartTime              The performance counter when the notification function was called.
+  @param  EndTime                The performance counter when the notification function returned.
+
+  @return The time spent in units of 100ns.
+
+**/
+UINT64
+CoreEventNotifyElapsedTime (
+  IN UINT64  StartTime,
+  IN UINT64  EndTime
+  )
+{
+  UINT64  Ticks;
+
+  if (mEventNotifyCounterStart == mEventNotifyCounterEnd) {
+    GetPerformanceCounterProperties (&mEventNotifyCounterStart, &mEventNotifyCounterEnd);
+  }
+
+  //
+  // The performance counter may count down.
+  //
+  if (mEventNotifyCounterEnd >= mEventNotifyCounterStart) {
+    Ticks = EndTime - StartTime;
+  } else {
+    Ticks = StartTime - EndTime;
+  }
+
+  return DivU64x32 (GetTimeInNanoSecond (Ticks), 100);
+}
+
+/**
+  Records the dispatch of an event notification function.
+
+  @param  NotifyFunction         The notification function of the event.
+  @param  NotifyTpl              The TPL the notification function ran at.
+  @param  EventType              The type of the event.
+  @param  Expired                TRUE if the dispatch was caused by the expiration of the timer of the event.
+  @param  Latency                The system time from the expiration of the timer to the dispatch.
+                                 Ignored if Expired is FALSE.
+  @param  StartTime              The performance counter when the notification function was called.
+  @param  EndTime                The performance counter when the notification function returned.
+
+**/
+VOID
+CoreRecordEventNotify (
+  IN EFI_EVENT_NOTIFY  NotifyFunction,
+  IN EFI_TPL           NotifyTpl,
+  IN UINT32            EventType,
+  IN BOOLEAN           Expired,
+  IN UINT64            Latency,
+  IN UINT64            StartTime,
+  IN UINT64            EndTime
+  )
+{
+  UINTN                              Index;
+  UINTN                              Probe;
+  EDKII_EVENT_NOTIFY_PROFILE_RECORD  *Record;
+  UINT64                             Time;
+
+  Time = CoreEventNotifyElapsedTime (StartTime, EndTime);
+
+  CoreAcquireLock (&mEventNotifyProfileLock);
+
+  //
+  // The profile is a hash table with linear probing, keyed by the notification
+  // function and the TPL.
+  //
+  Index  = (((UINTN)NotifyFunction >> 4) ^ NotifyTpl) & (EVENT_NOTIFY_PROFILE_MAX - 1);
+  Record = NULL;
+  for (Probe = 0; Probe < EVENT_NOTIFY_PROFILE_MAX; Probe++) {
+    Record = &mEventNotifyProfile[(Index + Probe) & (EVENT_NOTIFY_PROFILE_MAX - 1)];
+    if (Record->NotifyFunction == 0) {
+      Record->NotifyFunction = (PHYSICAL_ADDRESS)(UINTN)NotifyFunction;
+      Record->NotifyTpl      = NotifyTpl;
+      Record->EventType      = EventType;
+      break;
+    }
+
+    if ((Record->NotifyFunction == (PHYSICAL_ADDRESS)(UINTN)NotifyFunction) && (Record->NotifyTpl == NotifyTpl)) {
+      break;
+    }
+  }
+
+  if (Probe == EVENT_NOTIFY_PROFILE_MAX) {
+    mEventNotifyProfileDropped++;
+    CoreReleaseLock (&mEventNotifyProfileLock);
+    return;
+  }
+
+  Record->DispatchCount++;
+  Record->TotalTime += Time;
+  Record->MaxTime    = MAX (Record->MaxTime, Time);
+
+  if (Expired) {
+    Record->ExpiredCount++;
+    Record->TotalLatency += Latency;
+    Record->MaxLatency    = MAX (Record->MaxLatency, Latency);
+  }
+
+  CoreReleaseLock (&mEventNotifyProfileLock);
+}
+
+/**
+  Get the event notify profile.
+
+  @param[in]      This          The EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL instance.
+  @param[in, out] RecordCount   On input, the number of records the Records buffer can hold.
+                                On output, the number of records returned, or the number
+                                of records required if EFI_BUFFER_TOO_SMALL is returned.
+  @param[out]     Records       The buffer to return the records in.
+  @param[out]     DroppedCount  The number of dispatches that were not recorded because
+                                the profile was full. Optional.
+
+  @retval EFI_SUCCESS           The profile is returned.
+  @retval EFI_INVALID_PARAMETER RecordCount is NULL, or Records is NULL and *RecordCount is not 0.
+  @retval EFI_BUFFER_TOO_SMALL  The Records buffer is too small. *RecordCount is updated.
+
+**/
+EFI_STATUS
+EFIAPI
+EventNotifyProfileGetData (
+  IN     EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *This,
+  IN OUT UINTN                                *RecordCount,
+  OUT    EDKII_EVENT_NOTIFY_PROFILE_RECORD    *Records,
+  OUT    UINT64                               *DroppedCount OPTIONAL
+  )
+{
+  UINTN       Index;
+  UINTN       Count;
+  EFI_STATUS  Status;
+
+  if ((RecordCount == NULL) || ((Records == NULL) && (*RecordCount != 0))) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  CoreAcquireLock (&mEventNotifyProfileLock);
+
+  Count = 0;
+  for (Index = 0; Index < EVENT_NOTIFY_PROFILE_MAX; Index++) {
+    if (mEventNotifyProfile[Index].NotifyFunction != 0) {
+      Count++;
+    }
+  }
+
+  if (Count > *RecordCount) {
+    Status = EFI_BUFFER_TOO_SMALL;
+  } else {
+    Count = 0;
+    for (Index = 0; Index < EVENT_NOTIFY_PROFILE_MAX; Index++) {
+      if (mEventNotifyProfile[Index].NotifyFunction != 0) {
+        CopyMem (&Records[Count], &mEventNotifyProfile[Index], sizeof (EDKII_EVENT_NOTIFY_PROFILE_RECORD));
+        Count++;
+      }
+    }
+
+    Status = EFI_SUCCESS;
+  }
+
+  *RecordCount = Count;
+  if (DroppedCount != NULL) {
+    *DroppedCount = mEventNotifyProfileDropped;
+  }
+
+  CoreReleaseLock (&mEventNotifyProfileLock);
+
+  return Status;
+}
+
+/**
+  Clear the event notify profile.
+
+  @param[in] This  The EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The profile is cleared.
+
+**/
+EFI_STATUS
+EFIAPI
+EventNotifyProfileReset (
+  IN EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *This
+  )
+{
+  CoreAcquireLock (&mEventNotifyProfileLock);
+  ZeroMem (mEventNotifyProfile, sizeof (mEventNotifyProfile));
+  mEventNotifyProfileDropped = 0;
+  CoreReleaseLock (&mEventNotifyProfileLock);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Install event notify profile protocol.
+
+**/
+VOID
+EventNotifyProfileInstallProtocol (
+  VOID
+  )
+{
+  EFI_HANDLE  Handle;
+  EFI_STATUS  Status;
+
+  if (!FeaturePcdGet (PcdDxeCoreEventNotifyProfileEnable)) {
+    return;
+  }
+
+  Handle = NULL;
+  Status = CoreInstallMultipleProtocolInterfaces (
+             &Handle,
+             &gEdkiiEventNotifyProfileProtocolGuid,
+             &mEventNotifyProfileProtocol,
+             NULL
+             );
+  ASSERT_EFI_ERROR (Status);
+}
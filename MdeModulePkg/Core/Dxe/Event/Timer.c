@@ -9,48 +9,85 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "DxeMain.h"
 #include "Event.h"
 
+//
+// The timer database is a timing wheel of TIMER_WHEEL_SIZE slots, each covering
+// 2^TIMER_WHEEL_SLOT_SHIFT units of 100ns (about 13ms), backed by a sorted overflow
+// list for timers that expire beyond the span of the wheel (about 3.4s).
+// Each slot is kept in ascending sorted order, so walking the slots from
+// mEfiTimerWheelSlot signals the expired timers in the same order as a single
+// sorted list would, while setting a timer only walks the timers of one slot.
+//
+#define TIMER_WHEEL_SLOT_SHIFT  17
+#define TIMER_WHEEL_SIZE        256
+
 //
 // Internal data
 //
 
+LIST_ENTRY  mEfiTimerWheel[TIMER_WHEEL_SIZE];
+UINT64      mEfiTimerWheelSlot  = 0;
+UINTN       mEfiTimerWheelCount = 0;
 LIST_ENTRY  mEfiTimerList       = INITIALIZE_LIST_HEAD_VARIABLE (mEfiTimerList);
 EFI_LOCK    mEfiTimerLock       = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL - 1);
 EFI_EVENT   mEfiCheckTimerEvent = NULL;
 
-EFI_LOCK  mEfiSystemTimeLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL);
-UINT64    mEfiSystemTime     = 0;
+EFI_LOCK  mEfiSystemTimeLock   = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL);
+UINT64    mEfiSystemTime       = 0;
+UINT64    mEfiTimerNextTrigger = MAX_UINT64;
+
+//
+// Number of fired timers, counted if PcdDxeCoreTimerStatisticsEnable is TRUE
+//
+UINT64  mEfiTimerFiredCount = 0;
 
 //
 // Timer functions
 //
 
 /**
-  Inserts the timer event.
+  Sets the earliest trigger time that CoreTimerTick() compares the system time
+  against.
+
+  @param  TriggerTime            The new earliest trigger time.
+
+**/
+VOID
+CoreSetNextTimerTrigger (
+  IN UINT64  TriggerTime
+  )
+{
+  CoreAcquireLock (&mEfiSystemTimeLock);
+  mEfiTimerNextTrigger = TriggerTime;
+  CoreReleaseLock (&mEfiSystemTimeLock);
+}
+
+/**
+  Inserts the timer event into the sorted timer list.
 
+  @param  List                   The timer wheel slot or the overflow list.
   @param  Event                  Points to the internal structure of timer event
                                  to be installed
 
 **/
 VOID
-CoreInsertEventTimer (
-  IN IEVENT  *Event
+CoreInsertEventTimerSorted (
+  IN LIST_ENTRY  *List,
+  IN IEVENT      *Event
   )
 {
   UINT64      TriggerTime;
   LIST_ENTRY  *Link;
   IEVENT      *Event2;
 
-  ASSERT_LOCKED (&mEfiTimerLock);
-
   //
   // Get the timer's trigger time
   //
   TriggerTime = Event->Timer.TriggerTime;
 
   //
-  // Insert the timer into the timer database in assending sorted order
+  // Insert the timer into the list in assending sorted order
   //
-  for (Link = mEfiTimerList.ForwardLink; Link != &mEfiTimerList; Link = Link->ForwardLink) {
+  for (Link = List->ForwardLink; Link != List; Link = Link->ForwardLink) {
     Event2 = CR (Link, IEVENT, Timer.Link, EVENT_SIGNATURE);
 
     if (Event2->Timer.TriggerTime > TriggerTime) {
@@ -61,6 +98,124 @@ CoreInsertEventTimer (
   InsertTailList (Link, &Event->Timer.Link);
 }
 
+/**
+  Inserts the timer event.
+
+  @param  Event                  Points to the internal structure of timer event
+                                 to be installed
+
+**/
+VOID
+CoreInsertEventTimer (
+  IN IEVENT  *Event
+  )
+{
+  UINT64  Slot;
+
+  ASSERT_LOCKED (&mEfiTimerLock);
+
+  //
+  // Timers that are already expired go to the current slot.
+  //
+  Slot = RShiftU64 (Event->Timer.TriggerTime, TIMER_WHEEL_SLOT_SHIFT);
+  if (Slot < mEfiTimerWheelSlot) {
+    Slot = mEfiTimerWheelSlot;
+  }
+
+  if (Slot - mEfiTimerWheelSlot >= TIMER_WHEEL_SIZE) {
+    CoreInsertEventTimerSorted (&mEfiTimerList, Event);
+  } else {
+    CoreInsertEventTimerSorted (&mEfiTimerWheel[(UINTN)Slot & (TIMER_WHEEL_SIZE - 1)], Event);
+    mEfiTimerWheelCount++;
+  }
+
+  if (Event->Timer.TriggerTime < mEfiTimerNextTrigger) {
+    CoreSetNextTimerTrigger (Event->Timer.TriggerTime);
+  }
+}
+
+/**
+  Removes the timer event from the timer database.
+
+  @param  Event                  Points to the internal structure of timer event
+                                 to be removed
+
+**/
+VOID
+CoreRemoveEventTimer (
+  IN IEVENT  *Event
+  )
+{
+  ASSERT_LOCKED (&mEfiTimerLock);
+
+  //
+  // Timers in the overflow list are always beyond the span of the wheel.
+  //
+  if (RShiftU64 (Event->Timer.TriggerTime, TIMER_WHEEL_SLOT_SHIFT) < mEfiTimerWheelSlot + TIMER_WHEEL_SIZE) {
+    ASSERT (mEfiTimerWheelCount > 0);
+    mEfiTimerWheelCount--;
+  }
+
+  RemoveEntryList (&Event->Timer.Link);
+  Event->Timer.Link.ForwardLink = NULL;
+}
+
+/**
+  Moves the timers in the overflow list that are now within the span of the
+  wheel to their slots.
+
+**/
+VOID
+CoreCascadeEventTimers (
+  VOID
+  )
+{
+  IEVENT  *Event;
+
+  ASSERT_LOCKED (&mEfiTimerLock);
+
+  while (!IsListEmpty (&mEfiTimerList)) {
+    Event = CR (mEfiTimerList.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
+    if (RShiftU64 (Event->Timer.TriggerTime, TIMER_WHEEL_SLOT_SHIFT) >= mEfiTimerWheelSlot + TIMER_WHEEL_SIZE) {
+      break;
+    }
+
+    RemoveEntryList (&Event->Timer.Link);
+    CoreInsertEventTimer (Event);
+  }
+}
+
+/**
+  Recomputes the earliest trigger time of the timer database.
+
+**/
+VOID
+CoreUpdateNextTimerTrigger (
+  VOID
+  )
+{
+  UINTN       Index;
+  LIST_ENTRY  *Slot;
+  IEVENT      *Event;
+
+  ASSERT_LOCKED (&mEfiTimerLock);
+
+  Event = NULL;
+  if (mEfiTimerWheelCount != 0) {
+    for (Index = 0; Index < TIMER_WHEEL_SIZE; Index++) {
+      Slot = &mEfiTimerWheel[((UINTN)mEfiTimerWheelSlot + Index) & (TIMER_WHEEL_SIZE - 1)];
+      if (!IsListEmpty (Slot)) {
+        Event = CR (Slot->ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
+        break;
+      }
+    }
+  } else if (!IsListEmpty (&mEfiTimerList)) {
+    Event = CR (mEfiTimerList.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
+  }
+
+  CoreSetNextTimerTrigger ((Event != NULL) ? Event->Timer.TriggerTime : MAX_UINT64);
+}
+
 /**
   Returns the current system time.
 
@@ -82,7 +237,7 @@ CoreCurrentSystemTime (
 }
 
 /**
-  Checks the sorted timer list against the current system time.
+  Checks the timer database against the current system time.
   Signals any expired event timer.
 
   @param  CheckEvent             Not used
@@ -96,64 +251,140 @@ CoreCheckTimers (
   IN VOID       *Context
   )
 {
-  UINT64  SystemTime;
-  IEVENT  *Event;
+  UINT64      SystemTime;
+  UINT64      CurrentSlot;
+  LIST_ENTRY  *Slot;
+  IEVENT      *Event;
 
   //
   // Check the timer database for expired timers
   //
   CoreAcquireLock (&mEfiTimerLock);
-  SystemTime = CoreCurrentSystemTime ();
-
-  while (!IsListEmpty (&mEfiTimerList)) {
-    Event = CR (mEfiTimerList.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
+  SystemTime  = CoreCurrentSystemTime ();
+  CurrentSlot = RShiftU64 (SystemTime, TIMER_WHEEL_SLOT_SHIFT);
 
+  while (TRUE) {
     //
-    // If this timer is not expired, then we're done
+    // If there is no timer in the wheel, skip the empty slots at once
     //
-    if (Event->Timer.TriggerTime > SystemTime) {
-      break;
+    if ((mEfiTimerWheelCount == 0) && (mEfiTimerWheelSlot < CurrentSlot)) {
+      mEfiTimerWheelSlot = CurrentSlot;
+      CoreCascadeEventTimers ();
     }
 
-    //
-    // Remove this timer from the timer queue
-    //
-
-    RemoveEntryList (&Event->Timer.Link);
-    Event->Timer.Link.ForwardLink = NULL;
+    Slot = &mEfiTimerWheel[(UINTN)mEfiTimerWheelSlot & (TIMER_WHEEL_SIZE - 1)];
+    while (!IsListEmpty (Slot)) {
+      Event = CR (Slot->ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
 
-    //
-    // Signal it
-    //
-    CoreSignalEvent (Event);
+      //
+      // If this timer is not expired, then we're done
+      //
+      if (Event->Timer.TriggerTime > SystemTime) {
+        break;
+      }
 
-    //
-    // If this is a periodic timer, set it
-    //
-    if (Event->Timer.Period != 0) {
       //
-      // Compute the timers new trigger time
+      // Remove this timer from the timer queue
       //
-      Event->Timer.TriggerTime = Event->Timer.TriggerTime + Event->Timer.Period;
+      CoreRemoveEventTimer (Event);
 
       //
-      // If that's before now, then reset the timer to start from now
+      // Signal it
       //
-      if (Event->Timer.TriggerTime <= SystemTime) {
-        Event->Timer.TriggerTime = SystemTime;
-        CoreSignalEvent (mEfiCheckTimerEvent);
+      if (FeaturePcdGet (PcdDxeCoreTimerStatisticsEnable)) {
+        mEfiTimerFiredCount++;
+      }
+
+      if (FeaturePcdGet (PcdDxeCoreTimerStatisticsEnable) || FeaturePcdGet (PcdDxeCoreEventNotifyProfileEnable)) {
+        Event->Timer.DueTime = Event->Timer.TriggerTime;
+        Event->Timer.Expired = TRUE;
       }
 
+      CoreSignalEvent (Event);
+
       //
-      // Add the timer
+      // If this is a periodic timer, set it
       //
-      CoreInsertEventTimer (Event);
+      if (Event->Timer.Period != 0) {
+        //
+        // Compute the timers new trigger time
+        //
+        Event->Timer.TriggerTime = Event->Timer.TriggerTime + Event->Timer.Period;
+
+        //
+        // If that's before now, then reset the timer to start from now
+        //
+        if (Event->Timer.TriggerTime <= SystemTime) {
+          Event->Timer.TriggerTime = SystemTime;
+          CoreSignalEvent (mEfiCheckTimerEvent);
+        }
+
+        //
+        // Add the timer
+        //
+        CoreInsertEventTimer (Event);
+      }
     }
+
+    if (mEfiTimerWheelSlot >= CurrentSlot) {
+      break;
+    }
+
+    //
+    // All timers of this slot expired, move on to the next slot
+    //
+    mEfiTimerWheelSlot++;
+    CoreCascadeEventTimers ();
   }
 
+  CoreUpdateNextTimerTrigger ();
+
   CoreReleaseLock (&mEfiTimerLock);
 }
 
+/**
+  Dumps the timer statistics to the debug output.
+
+  All times are printed in units of 100ns.
+
+**/
+VOID
+CoreDumpTimerStatistics (
+  VOID
+  )
+{
+  UINTN                              Index;
+  EDKII_EVENT_NOTIFY_PROFILE_RECORD  *Record;
+
+  if (!FeaturePcdGet (PcdDxeCoreTimerStatisticsEnable)) {
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "Timer statistics: %ld timers fired\n", mEfiTimerFiredCount));
+  DEBUG ((DEBUG_INFO, "  NotifyFunction     Dispatches  AvgLatency  MaxLatency     AvgTime     MaxTime\n"));
+  for (Index = 0; Index < EVENT_NOTIFY_PROFILE_MAX; Index++) {
+    Record = &mEventNotifyProfile[Index];
+    if ((Record->DispatchCount == 0) || (Record->ExpiredCount == 0)) {
+      continue;
+    }
+
+    DEBUG ((
+      DEBUG_INFO,
+      "  %lx %10ld %11ld %11ld %11ld %11ld\n",
+      Record->NotifyFunction,
+      Record->DispatchCount,
+      DivU64x64Remainder (Record->TotalLatency, Record->ExpiredCount, NULL),
+      Record->MaxLatency,
+      DivU64x64Remainder (Record->TotalTime, Record->DispatchCount, NULL),
+      Record->MaxTime
+      ));
+  }
+
+  if (mEventNotifyProfileDropped != 0) {
+    DEBUG ((DEBUG_INFO, "  %ld dispatches not recorded\n", mEventNotifyProfileDropped));
+  }
+}
+
 /**
   Initializes timer support.
 
@@ -164,6 +395,11 @@ CoreInitializeTimer (
   )
 {
   EFI_STATUS  Status;
+  UINTN       Index;
+
+  for (Index = 0; Index < TIMER_WHEEL_SIZE; Index++) {
+    InitializeListHead (&mEfiTimerWheel[Index]);
+  }
 
   Status = CoreCreateEventInternal (
              EVT_NOTIFY_SIGNAL,
@@ -189,8 +425,6 @@ CoreTimerTick (
   IN UINT64  Duration
   )
 {
-  IEVENT  *Event;
-
   //
   // Check runtiem flag in case there are ticks while exiting boot services
   //
@@ -202,15 +436,11 @@ CoreTimerTick (
   mEfiSystemTime += Duration;
 
   //
-  // If the head of the list is expired, fire the timer event
+  // If the earliest timer is expired, fire the timer event
   // to process it
   //
-  if (!IsListEmpty (&mEfiTimerList)) {
-    Event = CR (mEfiTimerList.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
-
-    if (Event->Timer.TriggerTime <= mEfiSystemTime) {
-      CoreSignalEvent (mEfiCheckTimerEvent);
-    }
+  if (mEfiTimerNextTrigger <= mEfiSystemTime) {
+    CoreSignalEvent (mEfiCheckTimerEvent);
   }
 
   CoreReleaseLock (&mEfiSystemTimeLock);
@@ -261,8 +491,7 @@ CoreSetTimer (
   // If the timer is queued to the timer database, remove it
   //
   if (Event->Timer.Link.ForwardLink != NULL) {
-    RemoveEntryList (&Event->Timer.Link);
-    Event->Timer.Link.ForwardLink = NULL;
+    CoreRemoveEventTimer (Event);
   }
 
   Event->Timer.TriggerTime = 0;
@@ -1594,7 +1594,7 @@ CustomGuidedSectionExtract (
     AllocatedOutputBuffer = AllocatePool (OutputBufferSize);
     if (AllocatedOutputBuffer == NULL) {
       if (ScratchBuffer != NULL) {
-        FreePool (ScratchBuffer);
+        CoreFreePool (ScratchBuffer);
       }
 
       return EFI_OUT_OF_RESOURCES;
@@ -1612,6 +1612,15 @@ CustomGuidedSectionExtract (
              ScratchBuffer,
              AuthenticationStatus
              );
+
+  //
+  // The scratch buffer is no longer needed once decoding is done. Free it
+  // before copying the section contents to keep the peak allocation low.
+  //
+  if (ScratchBuffer != NULL) {
+    CoreFreePool (ScratchBuffer);
+  }
+
   if (EFI_ERROR (Status)) {
     //
     // Decode failed
@@ -1620,10 +1629,6 @@ CustomGuidedSectionExtract (
       CoreFreePool (AllocatedOutputBuffer);
     }
 
-    if (ScratchBuffer != NULL) {
-      CoreFreePool (ScratchBuffer);
-    }
-
     DEBUG ((DEBUG_ERROR, "Extract guided section Failed - %r\n", Status));
     return Status;
   }
@@ -1642,12 +1647,5 @@ CustomGuidedSectionExtract (
   //
   *OutputSize = (UINTN)OutputBufferSize;
 
-  //
-  // Free unused scratch buffer.
-  //
-  if (ScratchBuffer != NULL) {
-    CoreFreePool (ScratchBuffer);
-  }
-
   return EFI_SUCCESS;
 }
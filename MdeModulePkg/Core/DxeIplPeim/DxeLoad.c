@@ -624,6 +624,10 @@ CustomGuidedSectionExtract (
     //
     *OutputBuffer = AllocatePages (EFI_SIZE_TO_PAGES (OutputBufferSize));
     if (*OutputBuffer == NULL) {
+      if (ScratchBuffer != NULL) {
+        FreePages (ScratchBuffer, EFI_SIZE_TO_PAGES (ScratchBufferSize));
+      }
+
       return EFI_OUT_OF_RESOURCES;
     }
 
@@ -747,6 +751,7 @@ Decompress (
         //
         DstBuffer = AllocatePages (EFI_SIZE_TO_PAGES (DstBufferSize));
         if (DstBuffer == NULL) {
+          FreePages (ScratchBuffer, EFI_SIZE_TO_PAGES (ScratchBufferSize));
           return EFI_OUT_OF_RESOURCES;
         }
 
@@ -758,11 +763,19 @@ Decompress (
                    DstBuffer,
                    ScratchBuffer
                    );
+
+        //
+        // The scratch buffer is only needed while decoding, release it right
+        // away so that it does not add to the peak memory usage of PEI.
+        //
+        FreePages (ScratchBuffer, EFI_SIZE_TO_PAGES (ScratchBufferSize));
+
         if (EFI_ERROR (Status)) {
           //
           // Decompress failed
           //
           DEBUG ((DEBUG_ERROR, "Decompress Failed - %r\n", Status));
+          FreePages (DstBuffer, EFI_SIZE_TO_PAGES (DstBufferSize));
           return EFI_NOT_FOUND;
         }
 
@@ -0,0 +1,99 @@
+/** @file
+  Event Notify Profile Protocol is an EDK II-specific interface produced by the
+  DXE core to report the time spent in the notification functions of events.
+
+  The DXE core only produces this protocol if PcdDxeCoreEventNotifyProfileEnable
+  is TRUE.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EVENT_NOTIFY_PROFILE_H__
+#define __EVENT_NOTIFY_PROFILE_H__
+
+#define EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL_GUID \
+  { \
+    0x67a2e7e6, 0x0b26, 0x4a41, { 0x99, 0xc1, 0xcb, 0x87, 0x74, 0xb9, 0x79, 0x64 } \
+  }
+
+typedef struct _EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL;
+
+///
+/// The profile of one notification function at one TPL.
+/// All times are in units of 100ns. The time spent in the notification function
+/// is measured with the performance counter. The latency is measured with the
+/// DXE core system time, which advances on timer ticks like the timers themselves.
+///
+typedef struct {
+  PHYSICAL_ADDRESS    NotifyFunction;
+  UINT64              NotifyTpl;
+  ///
+  /// Type of the event the notification function was first dispatched for.
+  ///
+  UINT32              EventType;
+  UINT32              Reserved;
+  UINT64              DispatchCount;
+  UINT64              TotalTime;
+  UINT64              MaxTime;
+  ///
+  /// Number of dispatches caused by the expiration of the timer of the event.
+  /// Dispatches of a timer event signaled with SignalEvent() are not counted.
+  ///
+  UINT64              ExpiredCount;
+  ///
+  /// Time from the expiration of a timer event to the dispatch of its
+  /// notification function, summed over the ExpiredCount dispatches.
+  ///
+  UINT64              TotalLatency;
+  UINT64              MaxLatency;
+} EDKII_EVENT_NOTIFY_PROFILE_RECORD;
+
+/**
+  Get the event notify profile.
+
+  @param[in]      This          The EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL instance.
+  @param[in, out] RecordCount   On input, the number of records the Records buffer can hold.
+                                On output, the number of records returned, or the number
+                                of records required if EFI_BUFFER_TOO_SMALL is returned.
+  @param[out]     Records       The buffer to return the records in.
+  @param[out]     DroppedCount  The number of dispatches that were not recorded because
+                                the profile was full. Optional.
+
+  @retval EFI_SUCCESS           The profile is returned.
+  @retval EFI_INVALID_PARAMETER RecordCount is NULL, or Records is NULL and *RecordCount is not 0.
+  @retval EFI_BUFFER_TOO_SMALL  The Records buffer is too small. *RecordCount is updated.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_EVENT_NOTIFY_PROFILE_GET_DATA)(
+  IN     EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *This,
+  IN OUT UINTN                                *RecordCount,
+  OUT    EDKII_EVENT_NOTIFY_PROFILE_RECORD    *Records,
+  OUT    UINT64                               *DroppedCount OPTIONAL
+  );
+
+/**
+  Clear the event notify profile.
+
+  @param[in] This  The EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The profile is cleared.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_EVENT_NOTIFY_PROFILE_RESET)(
+  IN EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL  *This
+  );
+
+struct _EDKII_EVENT_NOTIFY_PROFILE_PROTOCOL {
+  EDKII_EVENT_NOTIFY_PROFILE_GET_DATA    GetData;
+  EDKII_EVENT_NOTIFY_PROFILE_RESET       Reset;
+};
+
+extern EFI_GUID  gEdkiiEventNotifyProfileProtocolGuid;
+
+#endif
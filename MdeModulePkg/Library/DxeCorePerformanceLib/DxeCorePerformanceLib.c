@@ -25,6 +25,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define STRING_SIZE                (FPDT_STRING_EVENT_RECORD_NAME_LENGTH * sizeof (CHAR8))
 #define FIRMWARE_RECORD_BUFFER     0x10000
 #define CACHE_HANDLE_GUID_COUNT    0x800
+#define CACHE_HANDLE_GUID_MAX      (CACHE_HANDLE_GUID_COUNT / 4 * 3)
 
 BOOT_PERFORMANCE_TABLE  *mAcpiBootPerformanceTable    = NULL;
 BOOT_PERFORMANCE_TABLE  mBootPerformanceTableTemplate = {
@@ -56,6 +57,10 @@ typedef struct {
   EFI_GUID      ModuleGuid;
 } HANDLE_GUID_MAP;
 
+//
+// Module name and GUID of the handles seen so far, hashed by handle. The table is
+// never filled beyond CACHE_HANDLE_GUID_MAX, so a lookup always ends at a free entry.
+//
 HANDLE_GUID_MAP  mCacheHandleGuidTable[CACHE_HANDLE_GUID_COUNT];
 UINTN            mCachePairCount = 0;
 
@@ -458,6 +463,31 @@ AllocateBootPerformanceTable (
   return EFI_SUCCESS;
 }
 
+/**
+  Find the entry of the handle in the module info cache.
+
+  @param    Handle        Image handle or Controller handle. Must not be NULL.
+
+  @return The entry that caches the handle, or the free entry to cache it in.
+**/
+HANDLE_GUID_MAP *
+GetCacheHandleGuidEntry (
+  IN EFI_HANDLE  Handle
+  )
+{
+  UINTN  Index;
+
+  //
+  // Handles are pool allocations, so the low bits carry no information.
+  //
+  Index = ((UINTN)Handle >> 3) & (CACHE_HANDLE_GUID_COUNT - 1);
+  while ((mCacheHandleGuidTable[Index].Handle != Handle) && (mCacheHandleGuidTable[Index].Handle != NULL)) {
+    Index = (Index + 1) & (CACHE_HANDLE_GUID_COUNT - 1);
+  }
+
+  return &mCacheHandleGuidTable[Index];
+}
+
 /**
   Get a human readable module name and module guid for the given image handle.
   If module name can't be found, "" string will return.
@@ -487,28 +517,40 @@ GetModuleInfoFromHandle (
   EFI_GUID                           *TempGuid;
   UINTN                              StartIndex;
   UINTN                              Index;
-  INTN                               Count;
   BOOLEAN                            ModuleGuidIsGet;
   UINTN                              StringSize;
   CHAR16                             *StringPtr;
   EFI_COMPONENT_NAME2_PROTOCOL       *ComponentName2;
   MEDIA_FW_VOL_FILEPATH_DEVICE_PATH  *FvFilePath;
+  HANDLE_GUID_MAP                    *CacheEntry;
 
   if ((NameString == NULL) || (BufferSize == 0)) {
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // A NULL handle has no name and no GUID.
+  //
+  if (Handle == NULL) {
+    NameString[0] = 0;
+    if (ModuleGuid != NULL) {
+      ZeroMem (ModuleGuid, sizeof (EFI_GUID));
+    }
+
+    return EFI_INVALID_PARAMETER;
+  }
+
   //
   // Try to get the ModuleGuid and name string form the caached array.
   //
-  if (mCachePairCount > 0) {
-    for (Count = mCachePairCount -1; Count >= 0; Count--) {
-      if (Handle == mCacheHandleGuidTable[Count].Handle) {
-        CopyGuid (ModuleGuid, &mCacheHandleGuidTable[Count].ModuleGuid);
-        AsciiStrCpyS (NameString, FPDT_STRING_EVENT_RECORD_NAME_LENGTH, mCacheHandleGuidTable[Count].NameString);
-        return EFI_SUCCESS;
-      }
+  CacheEntry = GetCacheHandleGuidEntry (Handle);
+  if (CacheEntry->Handle == Handle) {
+    if (ModuleGuid != NULL) {
+      CopyGuid (ModuleGuid, &CacheEntry->ModuleGuid);
     }
+
+    AsciiStrCpyS (NameString, BufferSize, CacheEntry->NameString);
+    return EFI_SUCCESS;
   }
 
   Status          = EFI_INVALID_PARAMETER;
@@ -524,38 +566,36 @@ GetModuleInfoFromHandle (
   //
   NameString[0] = 0;
 
-  if (Handle != NULL) {
+  //
+  // Try Handle as ImageHandle.
+  //
+  Status = gBS->HandleProtocol (
+                  Handle,
+                  &gEfiLoadedImageProtocolGuid,
+                  (VOID **)&LoadedImage
+                  );
+
+  if (EFI_ERROR (Status)) {
     //
-    // Try Handle as ImageHandle.
+    // Try Handle as Controller Handle
     //
-    Status = gBS->HandleProtocol (
+    Status = gBS->OpenProtocol (
                     Handle,
-                    &gEfiLoadedImageProtocolGuid,
-                    (VOID **)&LoadedImage
+                    &gEfiDriverBindingProtocolGuid,
+                    (VOID **)&DriverBinding,
+                    NULL,
+                    NULL,
+                    EFI_OPEN_PROTOCOL_GET_PROTOCOL
                     );
-
-    if (EFI_ERROR (Status)) {
+    if (!EFI_ERROR (Status)) {
       //
-      // Try Handle as Controller Handle
+      // Get Image protocol from ImageHandle
       //
-      Status = gBS->OpenProtocol (
-                      Handle,
-                      &gEfiDriverBindingProtocolGuid,
-                      (VOID **)&DriverBinding,
-                      NULL,
-                      NULL,
-                      EFI_OPEN_PROTOCOL_GET_PROTOCOL
+      Status = gBS->HandleProtocol (
+                      DriverBinding->ImageHandle,
+                      &gEfiLoadedImageProtocolGuid,
+                      (VOID **)&LoadedImage
                       );
-      if (!EFI_ERROR (Status)) {
-        //
-        // Get Image protocol from ImageHandle
-        //
-        Status = gBS->HandleProtocol (
-                        DriverBinding->ImageHandle,
-                        &gEfiLoadedImageProtocolGuid,
-                        (VOID **)&LoadedImage
-                        );
-      }
     }
   }
 
@@ -680,7 +720,7 @@ Done:
   //
   if (ModuleGuid != NULL) {
     CopyGuid (ModuleGuid, TempGuid);
-    if (IsZeroGuid (TempGuid) && (Handle != NULL) && !ModuleGuidIsGet) {
+    if (IsZeroGuid (TempGuid) && !ModuleGuidIsGet) {
       // Handle is GUID
       CopyGuid (ModuleGuid, (EFI_GUID *)Handle);
     }
@@ -689,10 +729,10 @@ Done:
   //
   // Cache the Handle and Guid pairs.
   //
-  if (mCachePairCount < CACHE_HANDLE_GUID_COUNT) {
-    mCacheHandleGuidTable[mCachePairCount].Handle = Handle;
-    CopyGuid (&mCacheHandleGuidTable[mCachePairCount].ModuleGuid, ModuleGuid);
-    AsciiStrCpyS (mCacheHandleGuidTable[mCachePairCount].NameString, FPDT_STRING_EVENT_RECORD_NAME_LENGTH, NameString);
+  if ((mCachePairCount < CACHE_HANDLE_GUID_MAX) && (ModuleGuid != NULL)) {
+    CacheEntry->Handle = Handle;
+    CopyGuid (&CacheEntry->ModuleGuid, ModuleGuid);
+    AsciiStrCpyS (CacheEntry->NameString, FPDT_STRING_EVENT_RECORD_NAME_LENGTH, NameString);
     mCachePairCount++;
   }
 
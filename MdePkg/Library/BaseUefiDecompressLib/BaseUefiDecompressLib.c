@@ -601,24 +601,36 @@ Decode (
       //
       DataIdx = Sd->mOutBuf - DecodeP (Sd) - 1;
 
-      //
-      // Write BytesRemain of bytes into mDstBase
-      //
-      BytesRemain--;
+      if ((DataIdx < Sd->mOutBuf) &&
+          ((UINT32)BytesRemain <= Sd->mOutBuf - DataIdx) &&
+          ((UINT32)BytesRemain <= Sd->mOrigSize - Sd->mOutBuf))
+      {
+        //
+        // The string neither overlaps the bytes being written nor runs past
+        // the end of mDstBase, so copy it in one go.
+        //
+        CopyMem (Sd->mDstBase + Sd->mOutBuf, Sd->mDstBase + DataIdx, BytesRemain);
+        Sd->mOutBuf += BytesRemain;
+      } else {
+        //
+        // Write BytesRemain of bytes into mDstBase
+        //
+        BytesRemain--;
 
-      while ((INT16)(BytesRemain) >= 0) {
-        if (Sd->mOutBuf >= Sd->mOrigSize) {
-          goto Done;
-        }
+        while ((INT16)(BytesRemain) >= 0) {
+          if (Sd->mOutBuf >= Sd->mOrigSize) {
+            goto Done;
+          }
 
-        if (DataIdx >= Sd->mOrigSize) {
-          Sd->mBadTableFlag = (UINT16)BAD_TABLE;
-          goto Done;
-        }
+          if (DataIdx >= Sd->mOrigSize) {
+            Sd->mBadTableFlag = (UINT16)BAD_TABLE;
+            goto Done;
+          }
 
-        Sd->mDstBase[Sd->mOutBuf++] = Sd->mDstBase[DataIdx++];
+          Sd->mDstBase[Sd->mOutBuf++] = Sd->mDstBase[DataIdx++];
 
-        BytesRemain--;
+          BytesRemain--;
+        }
       }
 
       //
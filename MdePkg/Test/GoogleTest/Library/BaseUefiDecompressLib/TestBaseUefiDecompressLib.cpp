@@ -0,0 +1,634 @@
+/** @file
+  Unit tests for BaseUefiDecompressLib using Google Test.
+
+  Decode() copies a back-reference that neither overlaps the bytes being
+  written nor runs past the end of the destination in one go. These tests
+  decode generated UEFI and Tiano streams with the library and with the
+  previous byte by byte Decode(), and expect the same output and status.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Library/GoogleTestLib.h>
+#include <random>
+#include <vector>
+
+extern "C" {
+  #include <Base.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/UefiDecompressLib.h>
+  #include "../../../../Library/BaseUefiDecompressLib/BaseUefiDecompressLibInternals.h"
+}
+
+//
+// The stream generator below uses fixed code lengths for each block, and a
+// window of 8 KB, which both the UEFI and the Tiano format accept.
+//
+#define TEST_NP          14
+#define TEST_WINDOW      (1U << (TEST_NP - 1))
+#define TEST_BLOCK_SIZE  0x4000
+
+//
+// A literal when Length is 0, else a back-reference.
+//
+struct Token {
+  UINT8     Literal;
+  UINT16    Length;
+  UINT32    Distance;
+};
+
+/**
+  The Decode() of the library before non-overlapping strings were copied in
+  one go, kept as the reference for the tests.
+
+  @param  Sd The global scratch data.
+
+**/
+STATIC
+VOID
+ReferenceDecode (
+  SCRATCH_DATA  *Sd
+  )
+{
+  UINT16  BytesRemain;
+  UINT32  DataIdx;
+  UINT16  CharC;
+
+  for ( ; ;) {
+    CharC = DecodeC (Sd);
+    if (Sd->mBadTableFlag != 0) {
+      return;
+    }
+
+    if (CharC < 256) {
+      if (Sd->mOutBuf >= Sd->mOrigSize) {
+        return;
+      }
+
+      Sd->mDstBase[Sd->mOutBuf++] = (UINT8)CharC;
+    } else {
+      CharC       = (UINT16)(CharC - (BIT8 - THRESHOLD));
+      BytesRemain = CharC;
+      DataIdx     = Sd->mOutBuf - DecodeP (Sd) - 1;
+
+      BytesRemain--;
+      while ((INT16)(BytesRemain) >= 0) {
+        if (Sd->mOutBuf >= Sd->mOrigSize) {
+          return;
+        }
+
+        if (DataIdx >= Sd->mOrigSize) {
+          Sd->mBadTableFlag = (UINT16)BAD_TABLE;
+          return;
+        }
+
+        Sd->mDstBase[Sd->mOutBuf++] = Sd->mDstBase[DataIdx++];
+
+        BytesRemain--;
+      }
+
+      if (Sd->mOutBuf >= Sd->mOrigSize) {
+        return;
+      }
+    }
+  }
+}
+
+/**
+  UefiTianoDecompress() running ReferenceDecode().
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  Destination The destination buffer to store the decompressed data.
+  @param  Scratch     A temporary scratch buffer that is used to perform the decompression.
+  @param  Version     1 for UEFI Decompress algorithm, 2 for Tiano Decompress algorithm.
+
+  @return The status UefiTianoDecompress() returned before the change.
+
+**/
+STATIC
+RETURN_STATUS
+ReferenceDecompress (
+  IN CONST VOID  *Source,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch,
+  IN UINT32      Version
+  )
+{
+  CONST UINT8   *Src;
+  SCRATCH_DATA  *Sd;
+
+  Src = (CONST UINT8 *)Source;
+  Sd  = (SCRATCH_DATA *)Scratch;
+
+  if (ReadUnaligned32 ((CONST UINT32 *)Src + 1) == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  SetMem (Sd, sizeof (SCRATCH_DATA), 0);
+  Sd->mPBit     = (UINT8)((Version == 1) ? 4 : 5);
+  Sd->mSrcBase  = (UINT8 *)Src + 8;
+  Sd->mDstBase  = (UINT8 *)Destination;
+  Sd->mCompSize = ReadUnaligned32 ((CONST UINT32 *)Src);
+  Sd->mOrigSize = ReadUnaligned32 ((CONST UINT32 *)Src + 1);
+
+  FillBuf (Sd, BITBUFSIZ);
+  ReferenceDecode (Sd);
+
+  return (Sd->mBadTableFlag != 0) ? RETURN_INVALID_PARAMETER : RETURN_SUCCESS;
+}
+
+//
+// Writes a bit stream most significant bit first, as FillBuf() reads it.
+//
+class BitWriter {
+public:
+  VOID
+  Put (
+    UINT32  Value,
+    UINT32  NumOfBits
+    )
+  {
+    while (NumOfBits-- > 0) {
+      mByte = (UINT8)((mByte << 1) | ((Value >> NumOfBits) & 1));
+      if (++mCount == 8) {
+        mBytes.push_back (mByte);
+        mByte  = 0;
+        mCount = 0;
+      }
+    }
+  }
+
+  std::vector<UINT8>
+  Finish (
+    )
+  {
+    if (mCount != 0) {
+      mBytes.push_back ((UINT8)(mByte << (8 - mCount)));
+      mByte  = 0;
+      mCount = 0;
+    }
+
+    return mBytes;
+  }
+
+private:
+  std::vector<UINT8>  mBytes;
+  UINT8               mByte  = 0;
+  UINT32              mCount = 0;
+};
+
+/**
+  Assign canonical Huffman codes to code lengths, the way MakeTable() does.
+**/
+STATIC
+std::vector<UINT16>
+CanonicalCodes (
+  const std::vector<UINT8>  &Lengths
+  )
+{
+  std::vector<UINT16>  Codes (Lengths.size ());
+  UINT32               Next[17] = { 0 };
+  UINT32               Code;
+  UINT32               Len;
+
+  Code = 0;
+  for (Len = 1; Len <= 16; Len++) {
+    Next[Len] = Code;
+    for (size_t Index = 0; Index < Lengths.size (); Index++) {
+      if (Lengths[Index] == Len) {
+        Code++;
+      }
+    }
+
+    Code <<= 1;
+  }
+
+  for (size_t Index = 0; Index < Lengths.size (); Index++) {
+    if (Lengths[Index] != 0) {
+      Codes[Index] = (UINT16)Next[Lengths[Index]]++;
+    }
+  }
+
+  return Codes;
+}
+
+/**
+  Build a compressed stream holding Tokens, with OrigSize in its header.
+**/
+STATIC
+std::vector<UINT8>
+Encode (
+  const std::vector<Token>  &Tokens,
+  UINT32                    OrigSize,
+  UINT32                    Version
+  )
+{
+  BitWriter            Writer;
+  std::vector<UINT8>   CLen (NC, 9);
+  std::vector<UINT8>   PLen (TEST_NP, 4);
+  std::vector<UINT16>  CCode;
+  std::vector<UINT16>  PCode;
+  std::vector<UINT8>   Stream;
+  UINT32               PBit;
+  UINT32               Pos;
+  UINT32               Sym;
+  size_t               Start;
+  size_t               Index;
+
+  //
+  // Complete prefix codes: 508 symbols of 9 bits and 2 of 8 bits for the
+  // Char&Len Set, 12 positions of 4 bits and 2 of 3 bits for the Position Set.
+  //
+  CLen[NC - 2] = 8;
+  CLen[NC - 1] = 8;
+  PLen[0]      = 3;
+  PLen[1]      = 3;
+  CCode        = CanonicalCodes (CLen);
+  PCode        = CanonicalCodes (PLen);
+  PBit         = (Version == 1) ? 4 : 5;
+
+  Start = 0;
+  do {
+    size_t  End = MIN (Start + TEST_BLOCK_SIZE, Tokens.size ());
+
+    Writer.Put ((UINT32)(End - Start), 16);
+
+    //
+    // Extra Set: code lengths 8 and 9 (symbols 10 and 11) as "0" and "1".
+    //
+    Writer.Put (12, TBIT);
+    Writer.Put (0, 3);
+    Writer.Put (0, 3);
+    Writer.Put (0, 3);
+    Writer.Put (3, 2);
+    for (Index = 6; Index < 10; Index++) {
+      Writer.Put (0, 3);
+    }
+
+    Writer.Put (1, 3);
+    Writer.Put (1, 3);
+
+    Writer.Put (NC, CBIT);
+    for (Index = 0; Index < NC; Index++) {
+      Writer.Put ((CLen[Index] == 9) ? 1 : 0, 1);
+    }
+
+    Writer.Put (TEST_NP, PBit);
+    for (Index = 0; Index < TEST_NP; Index++) {
+      Writer.Put (PLen[Index], 3);
+    }
+
+    for (Index = Start; Index < End; Index++) {
+      if (Tokens[Index].Length == 0) {
+        Writer.Put (CCode[Tokens[Index].Literal], CLen[Tokens[Index].Literal]);
+        continue;
+      }
+
+      Sym = Tokens[Index].Length + (BIT8 - THRESHOLD);
+      Writer.Put (CCode[Sym], CLen[Sym]);
+
+      Pos = Tokens[Index].Distance - 1;
+      Sym = (Pos < 2) ? Pos : (UINT32)HighBitSet32 (Pos) + 1;
+      Writer.Put (PCode[Sym], PLen[Sym]);
+      if (Sym > 1) {
+        Writer.Put (Pos - (1U << (Sym - 1)), Sym - 1);
+      }
+    }
+
+    Start = End;
+  } while (Start < Tokens.size ());
+
+  std::vector<UINT8>  Bits = Writer.Finish ();
+
+  Stream.resize (8);
+  WriteUnaligned32 ((UINT32 *)&Stream[0], (UINT32)Bits.size ());
+  WriteUnaligned32 ((UINT32 *)&Stream[4], OrigSize);
+  Stream.insert (Stream.end (), Bits.begin (), Bits.end ());
+  return Stream;
+}
+
+/**
+  Split Data into literals and the longest back-references found in the
+  window, overlapping ones included.
+**/
+STATIC
+std::vector<Token>
+Tokenize (
+  const std::vector<UINT8>  &Data
+  )
+{
+  std::vector<Token>  Tokens;
+  std::vector<INT32>  Head (1 << 16, -1);
+  std::vector<INT32>  Prev (Data.size (), -1);
+  size_t              Pos;
+  size_t              Len;
+
+  for (Pos = 0; Pos < Data.size (); ) {
+    UINT32  BestLen  = 0;
+    UINT32  BestDist = 0;
+    UINT32  Hash     = 0;
+
+    if (Pos + THRESHOLD <= Data.size ()) {
+      Hash = (Data[Pos] << 8 ^ Data[Pos + 1] << 4 ^ Data[Pos + 2]) & 0xFFFF;
+      for (INT32 Cand = Head[Hash], Tries = 0; Cand >= 0 && Tries < 64; Cand = Prev[Cand], Tries++) {
+        if (Pos - Cand > TEST_WINDOW) {
+          break;
+        }
+
+        for (Len = 0; Len < MAXMATCH && Pos + Len < Data.size () && Data[Cand + Len] == Data[Pos + Len]; Len++) {
+        }
+
+        if (Len > BestLen) {
+          BestLen  = (UINT32)Len;
+          BestDist = (UINT32)(Pos - Cand);
+        }
+      }
+    }
+
+    if (BestLen < THRESHOLD) {
+      BestLen = 1;
+      Tokens.push_back ({ Data[Pos], 0, 0 });
+    } else {
+      Tokens.push_back ({ 0, (UINT16)BestLen, BestDist });
+    }
+
+    for (Len = 0; Len < BestLen; Len++, Pos++) {
+      if (Pos + THRESHOLD <= Data.size ()) {
+        Hash       = (Data[Pos] << 8 ^ Data[Pos + 1] << 4 ^ Data[Pos + 2]) & 0xFFFF;
+        Prev[Pos]  = Head[Hash];
+        Head[Hash] = (INT32)Pos;
+      }
+    }
+  }
+
+  return Tokens;
+}
+
+/**
+  Expand Tokens the obvious way, up to OrigSize bytes.
+**/
+STATIC
+std::vector<UINT8>
+Expand (
+  const std::vector<Token>  &Tokens,
+  UINT32                    OrigSize
+  )
+{
+  std::vector<UINT8>  Data;
+
+  for (const Token &Tok : Tokens) {
+    if (Tok.Length == 0) {
+      Data.push_back (Tok.Literal);
+    } else {
+      for (UINT32 Index = 0; Index < Tok.Length; Index++) {
+        Data.push_back (Data[Data.size () - Tok.Distance]);
+      }
+    }
+  }
+
+  Data.resize (MIN ((UINT32)Data.size (), OrigSize));
+  return Data;
+}
+
+/**
+  Decode Stream with the library and with the reference, expect the same
+  output and status from both, and return them.
+**/
+STATIC
+RETURN_STATUS
+DecodeBoth (
+  const std::vector<UINT8>  &Stream,
+  UINT32                    Version,
+  std::vector<UINT8>        &Output
+  )
+{
+  RETURN_STATUS       Status;
+  RETURN_STATUS       ReferenceStatus;
+  UINT32              DestinationSize;
+  UINT32              ScratchSize;
+  std::vector<UINT8>  ReferenceOutput;
+  std::vector<UINT8>  Scratch;
+
+  Status = UefiDecompressGetInfo (Stream.data (), (UINT32)Stream.size (), &DestinationSize, &ScratchSize);
+  EXPECT_EQ (Status, RETURN_SUCCESS);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  Output.assign (DestinationSize, 0xCC);
+  ReferenceOutput.assign (DestinationSize, 0xCC);
+  Scratch.resize (ScratchSize);
+
+  Status          = UefiTianoDecompress (Stream.data (), Output.data (), Scratch.data (), Version);
+  ReferenceStatus = ReferenceDecompress (Stream.data (), ReferenceOutput.data (), Scratch.data (), Version);
+
+  EXPECT_EQ (Status, ReferenceStatus);
+  EXPECT_EQ (Output, ReferenceOutput);
+  return Status;
+}
+
+/**
+  Encode Tokens, then expect both decoders to produce their expansion.
+**/
+STATIC
+VOID
+CheckTokens (
+  const std::vector<Token>  &Tokens,
+  UINT32                    OrigSize
+  )
+{
+  std::vector<UINT8>  Output;
+
+  for (UINT32 Version = 1; Version <= 2; Version++) {
+    EXPECT_EQ (DecodeBoth (Encode (Tokens, OrigSize, Version), Version, Output), RETURN_SUCCESS);
+    EXPECT_EQ (Output, Expand (Tokens, OrigSize));
+  }
+}
+
+/**
+  Compress Data, then expect both decoders to restore it.
+**/
+STATIC
+VOID
+CheckData (
+  const std::vector<UINT8>  &Data
+  )
+{
+  CheckTokens (Tokenize (Data), (UINT32)Data.size ());
+}
+
+TEST (UefiDecompress, Distance1Run) {
+  std::vector<Token>  Tokens;
+
+  //
+  // Overlapping copies of one byte, with the maximum and minimum match lengths.
+  //
+  Tokens.push_back ({ 'A', 0, 0 });
+  for (int Index = 0; Index < 40; Index++) {
+    Tokens.push_back ({ 0, MAXMATCH, 1 });
+  }
+
+  Tokens.push_back ({ 0, THRESHOLD, 1 });
+  CheckTokens (Tokens, 1 + 40 * MAXMATCH + THRESHOLD);
+}
+
+TEST (UefiDecompress, OverlappingCopies) {
+  std::vector<Token>  Tokens;
+
+  //
+  // Strings that start inside the string being written, at every distance
+  // shorter than the length.
+  //
+  for (UINT32 Distance = 1; Distance < MAXMATCH; Distance++) {
+    for (UINT32 Index = 0; Index < Distance; Index++) {
+      Tokens.push_back ({ (UINT8)(Distance + Index), 0, 0 });
+    }
+
+    Tokens.push_back ({ 0, (UINT16)MIN (Distance + 1 + Distance % 7, MAXMATCH), Distance });
+  }
+
+  CheckTokens (Tokens, (UINT32)Expand (Tokens, MAX_UINT32).size ());
+}
+
+TEST (UefiDecompress, MaxMatchLength) {
+  std::vector<Token>  Tokens;
+
+  //
+  // Non-overlapping strings of the maximum length, at the shortest distance
+  // that does not overlap, and at the far end of the window.
+  //
+  for (UINT32 Index = 0; Index < TEST_WINDOW; Index++) {
+    Tokens.push_back ({ (UINT8)(Index * 7 + (Index >> 8)), 0, 0 });
+  }
+
+  Tokens.push_back ({ 0, MAXMATCH, MAXMATCH });
+  Tokens.push_back ({ 0, MAXMATCH, TEST_WINDOW });
+  Tokens.push_back ({ 0, MAXMATCH, MAXMATCH + 1 });
+  Tokens.push_back ({ 0, MAXMATCH, MAXMATCH - 1 });
+  CheckTokens (Tokens, (UINT32)Expand (Tokens, MAX_UINT32).size ());
+}
+
+TEST (UefiDecompress, MatchPastEnd) {
+  std::vector<Token>  Tokens;
+
+  //
+  // The last string runs past the original size, in both copy paths.
+  //
+  for (UINT32 Index = 0; Index < 600; Index++) {
+    Tokens.push_back ({ (UINT8)Index, 0, 0 });
+  }
+
+  Tokens.push_back ({ 0, MAXMATCH, 512 });
+  for (UINT32 Cut = 1; Cut < MAXMATCH; Cut += 17) {
+    CheckTokens (Tokens, 600 + MAXMATCH - Cut);
+  }
+
+  Tokens.back ().Distance = 2;
+  for (UINT32 Cut = 1; Cut < MAXMATCH; Cut += 17) {
+    CheckTokens (Tokens, 600 + MAXMATCH - Cut);
+  }
+}
+
+TEST (UefiDecompress, DistanceBeyondOutput) {
+  std::vector<Token>  Tokens;
+  std::vector<UINT8>  Output;
+
+  //
+  // A string that starts before the beginning of the output is rejected.
+  //
+  Tokens.push_back ({ 'x', 0, 0 });
+  Tokens.push_back ({ 'y', 0, 0 });
+  Tokens.push_back ({ 0, 10, 3 });
+  for (UINT32 Version = 1; Version <= 2; Version++) {
+    EXPECT_EQ (DecodeBoth (Encode (Tokens, 12, Version), Version, Output), RETURN_INVALID_PARAMETER);
+  }
+
+  //
+  // A string that starts at the beginning of the output is not.
+  //
+  Tokens.back ().Distance = 2;
+  CheckTokens (Tokens, 12);
+}
+
+TEST (UefiDecompress, RandomData) {
+  std::mt19937        Random (0x28);
+  std::vector<UINT8>  Data;
+
+  for (int Round = 0; Round < 16; Round++) {
+    Data.resize (1 + Random () % 0x8000);
+    for (UINT8 &Byte : Data) {
+      Byte = (UINT8)Random ();
+    }
+
+    CheckData (Data);
+  }
+}
+
+TEST (UefiDecompress, RepetitiveData) {
+  std::mt19937        Random (0x2828);
+  std::vector<UINT8>  Data;
+
+  //
+  // Small alphabets and repeated phrases give strings of every length and of
+  // many distances, both overlapping and not.
+  //
+  for (int Round = 0; Round < 32; Round++) {
+    UINT32  Alphabet = 1 + Random () % 8;
+
+    Data.clear ();
+    while (Data.size () < 0x10000) {
+      if (!Data.empty () && (Random () % 4 == 0)) {
+        size_t  Length = 1 + Random () % (2 * MAXMATCH);
+        size_t  From   = Data.size () - 1 - Random () % MIN (Data.size (), (size_t)TEST_WINDOW);
+
+        for (size_t Index = 0; Index < Length; Index++) {
+          Data.push_back (Data[From + Index]);
+        }
+      } else {
+        Data.push_back ((UINT8)('a' + Random () % Alphabet));
+      }
+    }
+
+    CheckData (Data);
+  }
+}
+
+TEST (UefiDecompress, CorruptedStreams) {
+  std::mt19937        Random (0x282828);
+  std::vector<UINT8>  Data;
+  std::vector<UINT8>  Stream;
+  std::vector<UINT8>  Output;
+
+  //
+  // Whatever the decoders make of a corrupted stream, they must agree.
+  //
+  Data.resize (0x4000);
+  for (size_t Index = 0; Index < Data.size (); Index++) {
+    Data[Index] = (UINT8)((Random () % 3 == 0) ? Random () : Data[Index / 2]);
+  }
+
+  for (UINT32 Version = 1; Version <= 2; Version++) {
+    std::vector<UINT8>  Valid = Encode (Tokenize (Data), (UINT32)Data.size (), Version);
+
+    for (int Round = 0; Round < 256; Round++) {
+      Stream = Valid;
+      for (int Flip = 0; Flip < 1 + Round % 4; Flip++) {
+        Stream[8 + Random () % (Stream.size () - 8)] ^= (UINT8)(1 + Random () % 255);
+      }
+
+      DecodeBoth (Stream, Version, Output);
+    }
+  }
+}
+
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  testing::InitGoogleTest (&argc, argv);
+  return RUN_ALL_TESTS ();
+}
@@ -28,25 +28,133 @@ EFI_DPC_PROTOCOL  mDpc = {
 };
 
 //
-// Global variables used to measure the DPC Queue Depths
+// The EDKII_DPC_STATISTICS_PROTOCOL instance that is installed onto mDpcHandle
 //
-UINTN  mDpcQueueDepth    = 0;
-UINTN  mMaxDpcQueueDepth = 0;
+EDKII_DPC_STATISTICS_PROTOCOL  mDpcStatistics = {
+  DpcGetStatistics,
+  DpcResetStatistics
+};
 
 //
-// Free list of DPC entries.  As DPCs are queued, entries are removed from this
-// free list.  As DPC entries are dispatched, DPC entries are added to the free list.
-// If the free list is empty and a DPC is queued, the free list is grown by allocating
-// an additional set of DPC entries.
+// An array of DPC queues.  A DPC queue is allocated for every level EFI_TPL value.
+// As DPCs are queued, they are added at the tail of the ring of the queue.
+// As DPCs are dispatched, they are removed from the head of the ring of the queue.
 //
-LIST_ENTRY  mDpcEntryFreeList = INITIALIZE_LIST_HEAD_VARIABLE (mDpcEntryFreeList);
+DPC_QUEUE  mDpcQueue[TPL_HIGH_LEVEL + 1];
 
 //
-// An array of DPC queues.  A DPC queue is allocated for every level EFI_TPL value.
-// As DPCs are queued, they are added to the end of the linked list.
-// As DPCs are dispatched, they are removed from the beginning of the linked list.
+// The number of DpcDispatchDpc() calls in progress, including the ones that
+// have been interrupted, and the rings that can be freed once it drops to 0.
 //
-LIST_ENTRY  mDpcQueue[TPL_HIGH_LEVEL + 1];
+UINTN     mDpcDispatchDepth  = 0;
+DPC_RING  *mDpcRetiredRings = NULL;
+
+/**
+  Allocate a ring of DPC entries.
+
+  @param  Size  The number of DPC entries in the ring.  Must be a power of two.
+
+  @return The allocated ring, or NULL if there are not enough resources.
+
+**/
+DPC_RING *
+DpcAllocateRing (
+  IN UINTN  Size
+  )
+{
+  DPC_RING  *Ring;
+
+  ASSERT ((Size & (Size - 1)) == 0);
+
+  Ring = AllocatePool (DPC_RING_ALLOCATION_SIZE (Size));
+  if (Ring != NULL) {
+    Ring->Size    = Size;
+    Ring->Retired = NULL;
+  }
+
+  return Ring;
+}
+
+/**
+  Replace the ring of a full or empty DPC queue by a larger one.
+
+  This function is called and returns at TPL_HIGH_LEVEL, but lowers the TPL to
+  OriginalTpl to allocate the ring, so the queue may have changed meanwhile.
+
+  @param  Queue        The DPC queue.
+  @param  OriginalTpl  The TPL DpcQueueDpc() was called at.
+
+  @retval EFI_SUCCESS           The ring of the queue was grown.
+  @retval EFI_OUT_OF_RESOURCES  Memory can not be allocated at OriginalTpl, or
+                                the allocation failed.
+
+**/
+EFI_STATUS
+DpcGrowQueue (
+  IN DPC_QUEUE  *Queue,
+  IN EFI_TPL    OriginalTpl
+  )
+{
+  DPC_RING  *OldRing;
+  DPC_RING  *NewRing;
+  UINTN     Size;
+  UINTN     Index;
+
+  //
+  // If the current TPL is greater than TPL_NOTIFY, then memory allocations
+  // can not be performed, so the ring can not be grown.
+  //
+  if (OriginalTpl > TPL_NOTIFY) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Size = (Queue->Ring == NULL) ? DPC_RING_INITIAL_SIZE : Queue->Ring->Size * 2;
+
+  //
+  // Lower the TPL level to perform a memory allocation
+  //
+  gBS->RestoreTPL (OriginalTpl);
+  NewRing = DpcAllocateRing (Size);
+  gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  if (NewRing == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  OldRing = Queue->Ring;
+  if ((OldRing != NULL) && (OldRing->Size >= Size)) {
+    //
+    // The ring was grown while the TPL was lowered.  The new ring was never used,
+    // but can not be freed at TPL_HIGH_LEVEL.
+    //
+    NewRing->Retired = mDpcRetiredRings;
+    mDpcRetiredRings = NewRing;
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Copy the queued DPC entries to the same positions modulo the new size, so
+  // Head and Tail stay valid.
+  //
+  if (OldRing != NULL) {
+    for (Index = Queue->Head; Index != Queue->Tail; Index++) {
+      NewRing->Entries[Index & (Size - 1)] = OldRing->Entries[Index & (OldRing->Size - 1)];
+    }
+  }
+
+  MemoryFence ();
+  Queue->Ring = NewRing;
+
+  //
+  // A dispatch interrupted by this function may still read from the old ring.
+  //
+  if (OldRing != NULL) {
+    OldRing->Retired = mDpcRetiredRings;
+    mDpcRetiredRings = OldRing;
+  }
+
+  return EFI_SUCCESS;
+}
 
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
@@ -75,8 +183,9 @@ DpcQueueDpc (
 {
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
+  DPC_QUEUE   *Queue;
   DPC_ENTRY   *DpcEntry;
-  UINTN       Index;
+  UINTN       Depth;
 
   //
   // Make sure DpcTpl is valid
@@ -98,93 +207,42 @@ DpcQueueDpc (
   ReturnStatus = EFI_SUCCESS;
 
   //
-  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operation and save the
+  // Raise the TPL level to TPL_HIGH_LEVEL for DPC queue operation and save the
   // current TPL value so it can be restored when this function returns.
   //
   OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
+  Queue = &mDpcQueue[DpcTpl];
+
   //
-  // Check to see if there are any entries in the DPC free list
+  // Grow the ring of the queue if it is full.  This is repeated, because other
+  // DPCs may be queued while the TPL is lowered for the allocation.
   //
-  if (IsListEmpty (&mDpcEntryFreeList)) {
-    //
-    // If the current TPL is greater than TPL_NOTIFY, then memory allocations
-    // can not be performed, so the free list can not be expanded.  In this case
-    // return EFI_OUT_OF_RESOURCES.
-    //
-    if (OriginalTpl > TPL_NOTIFY) {
-      ReturnStatus = EFI_OUT_OF_RESOURCES;
+  while ((Queue->Ring == NULL) || (Queue->Tail - Queue->Head == Queue->Ring->Size)) {
+    ReturnStatus = DpcGrowQueue (Queue, OriginalTpl);
+    if (EFI_ERROR (ReturnStatus)) {
+      Queue->FailedCount++;
       goto Done;
     }
-
-    //
-    // Add 64 DPC entries to the free list
-    //
-    for (Index = 0; Index < 64; Index++) {
-      //
-      // Lower the TPL level to perform a memory allocation
-      //
-      gBS->RestoreTPL (OriginalTpl);
-
-      //
-      // Allocate a new DPC entry
-      //
-      DpcEntry = AllocatePool (sizeof (DPC_ENTRY));
-
-      //
-      // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-      //
-      gBS->RaiseTPL (TPL_HIGH_LEVEL);
-
-      //
-      // If the allocation of a DPC entry fails, and the free list is empty,
-      // then return EFI_OUT_OF_RESOURCES.
-      //
-      if (DpcEntry == NULL) {
-        if (IsListEmpty (&mDpcEntryFreeList)) {
-          ReturnStatus = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
-      }
-
-      //
-      // Add the newly allocated DPC entry to the DPC free list
-      //
-      InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
-    }
   }
 
   //
-  // Retrieve the first node from the free list of DPCs
-  //
-  DpcEntry = (DPC_ENTRY *)(GetFirstNode (&mDpcEntryFreeList));
-
-  //
-  // Remove the first node from the free list of DPCs
-  //
-  RemoveEntryList (&DpcEntry->ListEntry);
-
-  //
-  // Fill in the DPC entry with the DpcProcedure and DpcContext
+  // Fill in the DPC entry at the tail of the ring with the DpcProcedure and
+  // DpcContext, and only then make it visible to DpcDispatchDpc().
   //
+  DpcEntry               = &Queue->Ring->Entries[Queue->Tail & (Queue->Ring->Size - 1)];
   DpcEntry->DpcProcedure = DpcProcedure;
   DpcEntry->DpcContext   = DpcContext;
+  MemoryFence ();
+  Queue->Tail++;
 
   //
-  // Add the DPC entry to the end of the list for the specified DplTpl.
-  //
-  InsertTailList (&mDpcQueue[DpcTpl], &DpcEntry->ListEntry);
-
-  //
-  // Increment the measured DPC queue depth across all TPLs
+  // Measure the number of DPCs queued and the maximum depth of the queue
   //
-  mDpcQueueDepth++;
-
-  //
-  // Measure the maximum DPC queue depth across all TPLs
-  //
-  if (mDpcQueueDepth > mMaxDpcQueueDepth) {
-    mMaxDpcQueueDepth = mDpcQueueDepth;
+  Queue->QueuedCount++;
+  Depth = Queue->Tail - Queue->Head;
+  if (Depth > Queue->MaxDepth) {
+    Queue->MaxDepth = Depth;
   }
 
 Done:
@@ -217,7 +275,10 @@ DpcDispatchDpc (
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
   EFI_TPL     Tpl;
-  DPC_ENTRY   *DpcEntry;
+  DPC_QUEUE   *Queue;
+  DPC_RING    *Ring;
+  DPC_RING    *Retired;
+  DPC_ENTRY   DpcEntry;
 
   //
   // Assume that no DPCs will be invoked
@@ -225,74 +286,170 @@ DpcDispatchDpc (
   ReturnStatus = EFI_NOT_FOUND;
 
   //
-  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operation and save the
+  // Raise the TPL level to TPL_HIGH_LEVEL to register this dispatch and save the
   // current TPL value so it can be restored when this function returns.
   //
   OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   //
-  // Check to see if there are 1 or more DPCs currently queued
+  // Check to see if there are 1 or more DPCs currently queued at or above the
+  // current TPL, which is the common case of the network drivers polling.
+  //
+  for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+    if (mDpcQueue[Tpl].Head != mDpcQueue[Tpl].Tail) {
+      break;
+    }
+  }
+
+  if (Tpl < OriginalTpl) {
+    gBS->RestoreTPL (OriginalTpl);
+    return ReturnStatus;
+  }
+
+  mDpcDispatchDepth++;
+  gBS->RestoreTPL (OriginalTpl);
+
+  //
+  // Loop from TPL_HIGH_LEVEL down to the current TPL value
   //
-  if (mDpcQueueDepth > 0) {
+  for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+    Queue = &mDpcQueue[Tpl];
+
     //
-    // Loop from TPL_HIGH_LEVEL down to the current TPL value
+    // Check to see if the DPC queue is empty
     //
-    for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+    if (Queue->Head == Queue->Tail) {
+      continue;
+    }
+
+    //
+    // Invoke the DPCs of the queue as one batch at the TPL of the queue.  The
+    // TPL does not have to be raised to TPL_HIGH_LEVEL to take each DPC, as
+    // DpcQueueDpc() only adds DPCs at the tail of the ring, and only a dispatch
+    // at this TPL takes them from the head.
+    //
+    gBS->RaiseTPL (Tpl);
+    while (Queue->Head != Queue->Tail) {
+      //
+      // Retrieve the first DPC entry from the DPC queue specified by Tpl, and
+      // only then release its slot in the ring.
+      //
+      Ring     = Queue->Ring;
+      DpcEntry = Ring->Entries[Queue->Head & (Ring->Size - 1)];
+      MemoryFence ();
+      Queue->Head++;
+      Queue->DispatchedCount++;
+
+      //
+      // Invoke the DPC passing in its context
       //
-      // Check to see if the DPC queue is empty
+      (DpcEntry.DpcProcedure)(DpcEntry.DpcContext);
+
       //
-      while (!IsListEmpty (&mDpcQueue[Tpl])) {
-        //
-        // Retrieve the first DPC entry from the DPC queue specified by Tpl
-        //
-        DpcEntry = (DPC_ENTRY *)(GetFirstNode (&mDpcQueue[Tpl]));
-
-        //
-        // Remove the first DPC entry from the DPC queue specified by Tpl
-        //
-        RemoveEntryList (&DpcEntry->ListEntry);
-
-        //
-        // Decrement the measured DPC Queue Depth across all TPLs
-        //
-        mDpcQueueDepth--;
-
-        //
-        // Lower the TPL to TPL value of the current DPC queue
-        //
-        gBS->RestoreTPL (Tpl);
-
-        //
-        // Invoke the DPC passing in its context
-        //
-        (DpcEntry->DpcProcedure)(DpcEntry->DpcContext);
-
-        //
-        // At least one DPC has been invoked, so set the return status to EFI_SUCCESS
-        //
-        ReturnStatus = EFI_SUCCESS;
-
-        //
-        // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-        //
-        gBS->RaiseTPL (TPL_HIGH_LEVEL);
-
-        //
-        // Add the invoked DPC entry to the DPC free list
-        //
-        InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
-      }
+      // At least one DPC has been invoked, so set the return status to EFI_SUCCESS
+      //
+      ReturnStatus = EFI_SUCCESS;
     }
+
+    gBS->RestoreTPL (OriginalTpl);
   }
 
   //
-  // Restore the original TPL level when this function was called
+  // Free the rings that were replaced, once no dispatch may read from them.
   //
+  Retired = NULL;
+  gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  mDpcDispatchDepth--;
+  if ((mDpcDispatchDepth == 0) && (OriginalTpl <= TPL_NOTIFY)) {
+    Retired          = mDpcRetiredRings;
+    mDpcRetiredRings = NULL;
+  }
+
   gBS->RestoreTPL (OriginalTpl);
 
+  while (Retired != NULL) {
+    Ring    = Retired;
+    Retired = Ring->Retired;
+    FreePool (Ring);
+  }
+
   return ReturnStatus;
 }
 
+/**
+  Get the statistics of the DPC queue of a TPL.
+
+  @param[in]  This        The EDKII_DPC_STATISTICS_PROTOCOL instance.
+  @param[in]  DpcTpl      The EFI_TPL of the DPC queue.
+  @param[out] Statistics  The statistics of the DPC queue.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  DpcTpl is not a valid EFI_TPL.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+DpcGetStatistics (
+  IN  EDKII_DPC_STATISTICS_PROTOCOL  *This,
+  IN  EFI_TPL                        DpcTpl,
+  OUT EDKII_DPC_STATISTICS           *Statistics
+  )
+{
+  EFI_TPL    OriginalTpl;
+  DPC_QUEUE  *Queue;
+
+  if ((DpcTpl < TPL_APPLICATION) || (DpcTpl > TPL_HIGH_LEVEL) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Queue       = &mDpcQueue[DpcTpl];
+  OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  Statistics->QueuedCount     = Queue->QueuedCount;
+  Statistics->DispatchedCount = Queue->DispatchedCount;
+  Statistics->FailedCount     = Queue->FailedCount;
+  Statistics->Depth           = Queue->Tail - Queue->Head;
+  Statistics->MaxDepth        = Queue->MaxDepth;
+  Statistics->Capacity        = (Queue->Ring == NULL) ? 0 : Queue->Ring->Size;
+
+  gBS->RestoreTPL (OriginalTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Clear the statistics of the DPC queues of all TPLs. The maximum depth of each
+  queue restarts from its current depth.
+
+  @param[in] This  The EDKII_DPC_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The statistics are cleared.
+
+**/
+EFI_STATUS
+EFIAPI
+DpcResetStatistics (
+  IN EDKII_DPC_STATISTICS_PROTOCOL  *This
+  )
+{
+  EFI_TPL  OriginalTpl;
+  UINTN    Index;
+
+  OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  for (Index = 0; Index <= TPL_HIGH_LEVEL; Index++) {
+    mDpcQueue[Index].QueuedCount     = 0;
+    mDpcQueue[Index].DispatchedCount = 0;
+    mDpcQueue[Index].FailedCount     = 0;
+    mDpcQueue[Index].MaxDepth        = mDpcQueue[Index].Tail - mDpcQueue[Index].Head;
+  }
+
+  gBS->RestoreTPL (OriginalTpl);
+
+  return EFI_SUCCESS;
+}
+
 /**
   The entry point for DPC driver which installs the EFI_DPC_PROTOCOL onto a new handle.
 
@@ -312,7 +469,6 @@ DpcDriverEntryPoint (
   )
 {
   EFI_STATUS  Status;
-  UINTN       Index;
 
   //
   // ASSERT() if the EFI_DPC_PROTOCOL is already present in the handle database
@@ -320,11 +476,13 @@ DpcDriverEntryPoint (
   ASSERT_PROTOCOL_ALREADY_INSTALLED (NULL, &gEfiDpcProtocolGuid);
 
   //
-  // Initialize the DPC queue for all possible TPL values
+  // Preallocate the rings of the DPC queues for the TPL values that the network
+  // drivers queue DPCs at, so DPCs can be queued above TPL_NOTIFY from the start.
+  // The rings of the other DPC queues are allocated when a DPC is first queued.
   //
-  for (Index = 0; Index <= TPL_HIGH_LEVEL; Index++) {
-    InitializeListHead (&mDpcQueue[Index]);
-  }
+  mDpcQueue[TPL_APPLICATION].Ring = DpcAllocateRing (DPC_RING_INITIAL_SIZE);
+  mDpcQueue[TPL_CALLBACK].Ring    = DpcAllocateRing (DPC_RING_INITIAL_SIZE);
+  mDpcQueue[TPL_NOTIFY].Ring      = DpcAllocateRing (DPC_RING_INITIAL_SIZE);
 
   //
   // Install the EFI_DPC_PROTOCOL instance onto a new handle
@@ -333,6 +491,8 @@ DpcDriverEntryPoint (
                   &mDpcHandle,
                   &gEfiDpcProtocolGuid,
                   &mDpc,
+                  &gEdkiiDpcStatisticsProtocolGuid,
+                  &mDpcStatistics,
                   NULL
                   );
   ASSERT_EFI_ERROR (Status);
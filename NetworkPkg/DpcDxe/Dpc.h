@@ -22,17 +22,55 @@ Abstract:
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Protocol/Dpc.h>
+#include <Protocol/DpcStatistics.h>
 
 //
-// Internal data structure for managing DPCs.  A DPC entry is either on the free
-// list or on a DPC queue at a specific EFI_TPL.
+// The number of DPC entries in the ring of a DPC queue when it is created.
+// Must be a power of two.  A full ring is replaced by one twice its size.
+//
+#define DPC_RING_INITIAL_SIZE  64
+
+//
+// Internal data structure for managing DPCs.  A DPC entry is a slot in the
+// ring of the DPC queue at a specific EFI_TPL.
 //
 typedef struct {
-  LIST_ENTRY           ListEntry;
   EFI_DPC_PROCEDURE    DpcProcedure;
   VOID                 *DpcContext;
 } DPC_ENTRY;
 
+typedef struct _DPC_RING DPC_RING;
+
+//
+// A ring of DPC entries.  When a ring is replaced by a larger one, it is kept on
+// the retired list until no DPC dispatch is in progress, because a dispatch that
+// was interrupted may still read from it.
+//
+struct _DPC_RING {
+  UINTN        Size;
+  DPC_RING     *Retired;
+  DPC_ENTRY    Entries[1];
+};
+
+#define DPC_RING_ALLOCATION_SIZE(Size)  (OFFSET_OF (DPC_RING, Entries) + (Size) * sizeof (DPC_ENTRY))
+
+//
+// The DPC queue of one EFI_TPL.  Head and Tail count the DPCs dispatched and
+// queued, and index the ring modulo its size.  Tail is only updated by
+// DpcQueueDpc() at TPL_HIGH_LEVEL.  Head is only updated by DpcDispatchDpc()
+// while it runs at the EFI_TPL of the queue, where no other dispatch of the same
+// queue can interrupt it, so DPCs are taken from the ring without raising the TPL.
+//
+typedef struct {
+  DPC_RING * volatile    Ring;
+  volatile UINTN         Head;
+  volatile UINTN         Tail;
+  UINT64                 QueuedCount;
+  UINT64                 DispatchedCount;
+  UINT64                 FailedCount;
+  UINTN                  MaxDepth;
+} DPC_QUEUE;
+
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
 
@@ -76,4 +114,39 @@ DpcDispatchDpc (
   IN EFI_DPC_PROTOCOL  *This
   );
 
+/**
+  Get the statistics of the DPC queue of a TPL.
+
+  @param[in]  This        The EDKII_DPC_STATISTICS_PROTOCOL instance.
+  @param[in]  DpcTpl      The EFI_TPL of the DPC queue.
+  @param[out] Statistics  The statistics of the DPC queue.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  DpcTpl is not a valid EFI_TPL.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+DpcGetStatistics (
+  IN  EDKII_DPC_STATISTICS_PROTOCOL  *This,
+  IN  EFI_TPL                        DpcTpl,
+  OUT EDKII_DPC_STATISTICS           *Statistics
+  );
+
+/**
+  Clear the statistics of the DPC queues of all TPLs. The maximum depth of each
+  queue restarts from its current depth.
+
+  @param[in] This  The EDKII_DPC_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The statistics are cleared.
+
+**/
+EFI_STATUS
+EFIAPI
+DpcResetStatistics (
+  IN EDKII_DPC_STATISTICS_PROTOCOL  *This
+  );
+
 #endif
@@ -597,21 +597,22 @@ HttpBootHttpIoCallback (
 }
 
 /**
-  Create a HttpIo instance for the file download.
+  Create and configure a HttpIo instance with the station address of the driver.
 
   @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HttpIo instance to create.
 
   @retval EFI_SUCCESS          Successfully created.
   @retval Others               Failed to create HttpIo.
 
 **/
 EFI_STATUS
-HttpBootCreateHttpIo (
-  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+HttpBootCreateHttpIoInstance (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
   )
 {
   HTTP_IO_CONFIG_DATA  ConfigData;
-  EFI_STATUS           Status;
   EFI_HANDLE           ImageHandle;
   UINT32               TimeoutValue;
 
@@ -636,15 +637,36 @@ HttpBootCreateHttpIo (
     ImageHandle = Private->Ip6Nic->ImageHandle;
   }
 
-  Status = HttpIoCreateIo (
-             ImageHandle,
-             Private->Controller,
-             Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
-             &ConfigData,
-             HttpBootHttpIoCallback,
-             (VOID *)Private,
-             &Private->HttpIo
-             );
+  return HttpIoCreateIo (
+           ImageHandle,
+           Private->Controller,
+           Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
+           &ConfigData,
+           HttpBootHttpIoCallback,
+           (VOID *)Private,
+           HttpIo
+           );
+}
+
+/**
+  Create a HttpIo instance for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+
+  ASSERT (Private != NULL);
+
+  Status = HttpBootCreateHttpIoInstance (Private, &Private->HttpIo);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -1520,6 +1542,20 @@ HttpBootGetBootFile (
     Cache->ImageType    = *ImageType;
   }
 
+  //
+  // 3.2.1 Remember whether the server accepts byte ranges, which allows to
+  // download the file in parallel.
+  //
+  if (HeaderOnly) {
+    HttpHeader = HttpFindHeader (
+                   ResponseData->HeaderCount,
+                   ResponseData->Headers,
+                   HTTP_HEADER_ACCEPT_RANGES
+                   );
+    Private->AcceptRanges = (BOOLEAN)((HttpHeader != NULL) &&
+                                      (AsciiStrnCmp (HttpHeader->FieldValue, "bytes", 5) == 0));
+  }
+
   // Cache ETag or Last-Modified response header value to
   // be used when resuming an interrupted download.
   HttpHeader = HttpFindHeader (
@@ -1804,3 +1840,348 @@ ERROR_1:
 
   return Status;
 }
+
+/**
+  Build the HTTP headers to request a byte range of the boot file.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in]       Offset          The offset of the first byte of the range.
+  @param[in]       Length          The length of the range in bytes.
+  @param[out]      HttpIoHeader    The headers built. Free with HttpIoFreeHeader().
+
+  @retval EFI_SUCCESS              The headers were built.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_UNSUPPORTED          The authentication scheme is not supported.
+  @retval Others                   Unexpected error happened.
+
+**/
+STATIC
+EFI_STATUS
+HttpBootBuildRangeHeader (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     UINTN                   Offset,
+  IN     UINTN                   Length,
+  OUT    HTTP_IO_HEADER          **HttpIoHeader
+  )
+{
+  EFI_STATUS      Status;
+  HTTP_IO_HEADER  *Header;
+  CHAR8           *HostName;
+  CHAR8           BaseAuthValue[80];
+  CHAR8           RangeValue[64];
+  UINTN           HeadersCount;
+
+  //
+  // Host, Accept, User-Agent, Range and Connection, plus the optional Authorization
+  // and If-Match or If-Unmodified-Since, the latter making sure that all the ranges
+  // come from the same version of the file.
+  //
+  HeadersCount = 5;
+  if (Private->AuthData != NULL) {
+    HeadersCount++;
+  }
+
+  if (Private->LastModifiedOrEtag != NULL) {
+    HeadersCount++;
+  }
+
+  Header = HttpIoCreateHeader (HeadersCount);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  HostName = NULL;
+  Status   = HttpUrlGetHostName (
+               Private->BootFileUri,
+               Private->BootFileUriParser,
+               &HostName
+               );
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_HOST, HostName);
+  FreePool (HostName);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_ACCEPT, "*/*");
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_USER_AGENT, HTTP_USER_AGENT_EFI_HTTP_BOOT);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  AsciiSPrint (RangeValue, sizeof (RangeValue), "bytes=%lu-%lu", (UINT64)Offset, (UINT64)(Offset + Length - 1));
+  Status = HttpIoSetHeader (Header, "Range", RangeValue);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  //
+  // Each connection carries a single range. Have the server close it once the
+  // range is sent, so that a connection whose response was not read completely,
+  // when the download fails and starts over on a single connection, is never
+  // kept for reuse.
+  //
+  Status = HttpIoSetHeader (Header, "Connection", "close");
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  if (Private->AuthData != NULL) {
+    if ((Private->AuthScheme != NULL) && (CompareMem (Private->AuthScheme, "Basic", 5) != 0)) {
+      Status = EFI_UNSUPPORTED;
+      goto ON_ERROR;
+    }
+
+    AsciiSPrint (BaseAuthValue, sizeof (BaseAuthValue), "%a %a", "Basic", Private->AuthData);
+    Status = HttpIoSetHeader (Header, HTTP_HEADER_AUTHORIZATION, BaseAuthValue);
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  if (Private->LastModifiedOrEtag != NULL) {
+    //
+    // An ETag value starts with "
+    //
+    Status = HttpIoSetHeader (
+               Header,
+               Private->LastModifiedOrEtag[0] == '"' ? HTTP_HEADER_IF_MATCH : HTTP_HEADER_IF_UNMODIFIED_SINCE,
+               Private->LastModifiedOrEtag
+               );
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  *HttpIoHeader = Header;
+  return EFI_SUCCESS;
+
+ON_ERROR:
+  HttpIoFreeHeader (Header);
+  return Status;
+}
+
+/**
+  This function downloads the boot file in byte ranges, each on its own HTTP
+  connection, so that the ranges are transferred at the same time.
+
+  The size of the boot file must have been retrieved with the HEAD method, and
+  the server must have reported that it accepts byte ranges.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to
+                                   Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The parallel download is disabled, or the file is too small,
+                                   or a proxy is used. Nothing was sent to the server.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   The download failed. The HttpIo of the driver is in an
+                                   unknown state and must be recreated.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileRanges (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  )
+{
+  EFI_STATUS             Status;
+  UINTN                  RangeCount;
+  UINTN                  RangeSize;
+  UINTN                  Index;
+  UINTN                  Remaining;
+  HTTP_BOOT_RANGE        *Ranges;
+  HTTP_BOOT_RANGE        *Range;
+  HTTP_IO_HEADER         *HttpIoHeader;
+  EFI_HTTP_REQUEST_DATA  RequestData;
+  HTTP_IO_RESPONSE_DATA  ResponseData;
+  EFI_HTTP_HEADER        *HttpHeader;
+  CHAR8                  ContentRange[80];
+  UINTN                  UrlSize;
+  CHAR16                 *Url;
+
+  ASSERT (Private != NULL);
+  ASSERT (Private->HttpCreated);
+
+  if ((BufferSize == NULL) || (Buffer == NULL) || (ImageType == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // The extra connections would not go through the proxy.
+  //
+  RangeCount = MIN (PcdGet8 (PcdHttpBootParallelDownloadCount), HTTP_BOOT_PARALLEL_MAX_RANGES);
+  RangeCount = MIN (RangeCount, Private->BootFileSize / HTTP_BOOT_PARALLEL_MIN_RANGE_SIZE);
+  if ((RangeCount < 2) || (Private->ProxyUri != NULL) || (*BufferSize < Private->BootFileSize)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  UrlSize = AsciiStrSize (Private->BootFileUri);
+  Url     = AllocatePool (UrlSize * sizeof (CHAR16));
+  if (Url == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  AsciiStrToUnicodeStrS (Private->BootFileUri, Url, UrlSize);
+
+  Ranges = AllocateZeroPool (RangeCount * sizeof (HTTP_BOOT_RANGE));
+  if (Ranges == NULL) {
+    FreePool (Url);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  DEBUG ((DEBUG_INFO, "HttpBootGetBootFileRanges: Download %lu bytes in %lu ranges.\n", (UINT64)Private->BootFileSize, (UINT64)RangeCount));
+
+  RequestData.Method = HttpMethodGet;
+  RequestData.Url    = Url;
+
+  //
+  // 1. Send the request for each range on its own connection. The first range
+  // reuses the connection of the HEAD request.
+  //
+  RangeSize = Private->BootFileSize / RangeCount;
+  for (Index = 0; Index < RangeCount; Index++) {
+    Range         = &Ranges[Index];
+    Range->Offset = Index * RangeSize;
+    Range->Length = (Index == RangeCount - 1) ? Private->BootFileSize - Range->Offset : RangeSize;
+    if (Index == 0) {
+      Range->HttpIo = &Private->HttpIo;
+    } else {
+      Status = HttpBootCreateHttpIoInstance (Private, &Range->Io);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+
+      Range->IoCreated = TRUE;
+      Range->HttpIo    = &Range->Io;
+    }
+
+    Status = HttpBootBuildRangeHeader (Private, Range->Offset, Range->Length, &HttpIoHeader);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Status = HttpIoSendRequest (
+               Range->HttpIo,
+               &RequestData,
+               HttpIoHeader->HeaderCount,
+               HttpIoHeader->Headers,
+               0,
+               NULL
+               );
+    HttpIoFreeHeader (HttpIoHeader);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+  }
+
+  //
+  // 2. Receive the response headers, each must return exactly the range requested.
+  //
+  for (Index = 0; Index < RangeCount; Index++) {
+    Range = &Ranges[Index];
+    ZeroMem (&ResponseData, sizeof (HTTP_IO_RESPONSE_DATA));
+    Status = HttpIoRecvResponse (Range->HttpIo, TRUE, &ResponseData);
+    if (!EFI_ERROR (Status) && EFI_ERROR (ResponseData.Status)) {
+      Status = ResponseData.Status;
+    }
+
+    if (!EFI_ERROR (Status)) {
+      AsciiSPrint (
+        ContentRange,
+        sizeof (ContentRange),
+        "bytes %lu-%lu/%lu",
+        (UINT64)Range->Offset,
+        (UINT64)(Range->Offset + Range->Length - 1),
+        (UINT64)Private->BootFileSize
+        );
+      HttpHeader = HttpFindHeader (ResponseData.HeaderCount, ResponseData.Headers, HTTP_HEADER_CONTENT_RANGE);
+      if ((ResponseData.Response.StatusCode != HTTP_STATUS_206_PARTIAL_CONTENT) ||
+          (HttpHeader == NULL) ||
+          (AsciiStrCmp (HttpHeader->FieldValue, ContentRange) != 0))
+      {
+        DEBUG ((DEBUG_WARN | DEBUG_INFO, "HttpBootGetBootFileRanges: Unexpected response for range %a.\n", ContentRange));
+        Status = EFI_UNSUPPORTED;
+      }
+    }
+
+    if (ResponseData.Headers != NULL) {
+      FreePool (ResponseData.Headers);
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+  }
+
+  //
+  // 3. Receive the bodies directly into the buffer. Take turns between the
+  // connections, so that none of them stalls on a full receive window while
+  // another one is read.
+  //
+  do {
+    Remaining = 0;
+    for (Index = 0; Index < RangeCount; Index++) {
+      Range = &Ranges[Index];
+      if (Range->ReceivedSize == Range->Length) {
+        continue;
+      }
+
+      ZeroMem (&ResponseData, sizeof (HTTP_IO_RESPONSE_DATA));
+      ResponseData.Body       = (CHAR8 *)Buffer + Range->Offset + Range->ReceivedSize;
+      ResponseData.BodyLength = Range->Length - Range->ReceivedSize;
+      Status                  = HttpIoRecvResponse (Range->HttpIo, FALSE, &ResponseData);
+      if (!EFI_ERROR (Status) && EFI_ERROR (ResponseData.Status)) {
+        Status = ResponseData.Status;
+      }
+
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+
+      Range->ReceivedSize += ResponseData.BodyLength;
+      Remaining           += Range->Length - Range->ReceivedSize;
+
+      if (Private->HttpBootCallback != NULL) {
+        Status = Private->HttpBootCallback->Callback (
+                                              Private->HttpBootCallback,
+                                              HttpBootHttpEntityBody,
+                                              TRUE,
+                                              (UINT32)ResponseData.BodyLength,
+                                              ResponseData.Body
+                                              );
+        if (EFI_ERROR (Status)) {
+          goto ON_EXIT;
+        }
+      }
+    }
+  } while (Remaining != 0);
+
+  *BufferSize = Private->BootFileSize;
+  *ImageType  = Private->ImageType;
+  Status      = EFI_SUCCESS;
+
+ON_EXIT:
+  for (Index = 0; Index < RangeCount; Index++) {
+    if (Ranges[Index].IoCreated) {
+      HttpIoDestroyIo (&Ranges[Index].Io);
+    }
+  }
+
+  FreePool (Ranges);
+  FreePool (Url);
+  return Status;
+}
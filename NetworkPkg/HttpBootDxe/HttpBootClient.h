@@ -14,6 +14,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define HTTP_USER_AGENT_EFI_HTTP_BOOT          "UefiHttpBoot/1.0"
 #define HTTP_BOOT_AUTHENTICATION_INFO_MAX_LEN  255
 
+//
+// Limits of the parallel download of a boot file in byte ranges.
+//
+#define HTTP_BOOT_PARALLEL_MIN_RANGE_SIZE  SIZE_4MB
+#define HTTP_BOOT_PARALLEL_MAX_RANGES      16
+
 //
 // Record the data length and start address of a data block.
 //
@@ -58,6 +64,18 @@ typedef struct {
   HTTP_BOOT_PRIVATE_DATA     *Private;
 } HTTP_BOOT_CALLBACK_DATA;
 
+//
+// One byte range of a boot file downloaded in parallel.
+//
+typedef struct {
+  HTTP_IO    *HttpIo;                     // Points to Io, or to the HttpIo of the driver for the first range
+  HTTP_IO    Io;
+  BOOLEAN    IoCreated;
+  UINTN      Offset;
+  UINTN      Length;
+  UINTN      ReceivedSize;
+} HTTP_BOOT_RANGE;
+
 /**
   Discover all the boot information for boot file.
 
@@ -136,6 +154,36 @@ HttpBootGetBootFile (
   OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
   );
 
+/**
+  This function downloads the boot file in byte ranges, each on its own HTTP
+  connection, so that the ranges are transferred at the same time.
+
+  The size of the boot file must have been retrieved with the HEAD method, and
+  the server must have reported that it accepts byte ranges.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in, out]  BufferSize      On input the size of Buffer in bytes. On output with a return
+                                   code of EFI_SUCCESS, the amount of data transferred to
+                                   Buffer.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+  @param[out]      ImageType       The image type of the downloaded file.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_UNSUPPORTED          The parallel download is disabled, or the file is too small,
+                                   or a proxy is used. Nothing was sent to the server.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   The download failed. The HttpIo of the driver is in an
+                                   unknown state and must be recreated.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileRanges (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN OUT UINTN                   *BufferSize,
+  OUT UINT8                      *Buffer,
+  OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
+  );
+
 /**
   Clean up all cached data.
 
@@ -394,6 +394,27 @@ HttpBootGetBootFileCaller (
           return Status;
         }
 
+        //
+        // Load a large boot file in several ranges at the same time if the
+        // server supports it. On failure, start over on a single connection.
+        //
+        if (Private->AcceptRanges && (Buffer != NULL) && (Private->PartialTransferredSize == 0)) {
+          Status = HttpBootGetBootFileRanges (Private, BufferSize, Buffer, ImageType);
+          if (!EFI_ERROR (Status)) {
+            return Status;
+          }
+
+          if (Status != EFI_UNSUPPORTED) {
+            DEBUG ((DEBUG_WARN | DEBUG_INFO, "HttpBootGetBootFileCaller: Parallel download failed - %r, retry on a single connection.\n", Status));
+            Private->HttpCreated = FALSE;
+            HttpIoDestroyIo (&Private->HttpIo);
+            Status = HttpBootCreateHttpIo (Private);
+            if (EFI_ERROR (Status)) {
+              return Status;
+            }
+          }
+        }
+
         //
         // Load the boot file into Buffer
         //
@@ -584,6 +605,7 @@ HttpBootStop (
   Private->SelectIndex            = 0;
   Private->SelectProxyType        = HttpOfferTypeMax;
   Private->PartialTransferredSize = 0;
+  Private->AcceptRanges           = FALSE;
 
   if (!Private->UsingIpv6) {
     //
@@ -66,7 +66,11 @@ HttpCreateService (
   HttpService->ServiceBinding.DestroyChild = HttpServiceBindingDestroyChild;
   HttpService->ControllerHandle            = Controller;
   HttpService->ChildrenNumber              = 0;
+
+  HttpService->ConnectionPoolStatistics.GetStatistics = HttpConnectionPoolGetStatistics;
+  HttpService->ConnectionPoolStatistics.Reset         = HttpConnectionPoolResetStatistics;
   InitializeListHead (&HttpService->ChildrenList);
+  InitializeListHead (&HttpService->ConnectionPool);
 
   *ServiceData = HttpService;
   return EFI_SUCCESS;
@@ -90,6 +94,8 @@ HttpCleanService (
     return;
   }
 
+  HttpConnectionPoolFlush (HttpService, UsingIpv6);
+
   if (!UsingIpv6) {
     if (HttpService->Tcp4ChildHandle != NULL) {
       gBS->CloseProtocol (
@@ -376,12 +382,14 @@ HttpDxeStart (
     ASSERT (HttpService != NULL);
 
     //
-    // Install the HttpServiceBinding Protocol onto Controller
+    // Install the HttpServiceBinding Protocol and the connection pool statistics onto Controller
     //
     Status = gBS->InstallMultipleProtocolInterfaces (
                     &ControllerHandle,
                     &gEfiHttpServiceBindingProtocolGuid,
                     &HttpService->ServiceBinding,
+                    &gEdkiiHttpConnectionPoolStatisticsProtocolGuid,
+                    &HttpService->ConnectionPoolStatistics,
                     NULL
                     );
 
@@ -469,6 +477,8 @@ ON_ERROR:
                     &ControllerHandle,
                     &gEfiHttpServiceBindingProtocolGuid,
                     &HttpService->ServiceBinding,
+                    &gEdkiiHttpConnectionPoolStatisticsProtocolGuid,
+                    &HttpService->ConnectionPoolStatistics,
                     NULL
                     );
     if (!EFI_ERROR (Status)) {
@@ -562,10 +572,13 @@ HttpDxeStop (
       HttpCleanService (HttpService, UsingIpv6);
 
       if ((HttpService->Tcp4ChildHandle == NULL) && (HttpService->Tcp6ChildHandle == NULL)) {
-        gBS->UninstallProtocolInterface (
+        gBS->UninstallMultipleProtocolInterfaces (
                NicHandle,
                &gEfiHttpServiceBindingProtocolGuid,
-               ServiceBinding
+               ServiceBinding,
+               &gEdkiiHttpConnectionPoolStatisticsProtocolGuid,
+               &HttpService->ConnectionPoolStatistics,
+               NULL
                );
         FreePool (HttpService);
       }
@@ -51,6 +51,7 @@
 #include <Protocol/Tls.h>
 #include <Protocol/TlsConfig.h>
 #include <Protocol/HttpCallback.h>
+#include <Protocol/HttpConnectionPoolStatistics.h>
 
 #include <Guid/ImageAuthentication.h>
 //
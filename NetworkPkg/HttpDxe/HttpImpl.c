@@ -257,6 +257,8 @@ EfiHttpRequest (
   UINT16                         EndPointRemotePort;
   CHAR8                          *EndPointUrlMsg;
   EFI_HTTP_CONNECT_REQUEST_DATA  *ConnRequest;
+  BOOLEAN                        Pooled;
+  EFI_HTTP_HEADER                *ConnectionHeader;
 
   //
   // Initializations
@@ -275,6 +277,7 @@ EfiHttpRequest (
   EndPointUrlMsg     = NULL;
   EndPointRemotePort = 0;
   ConnRequest        = NULL;
+  Pooled             = FALSE;
 
   if ((This == NULL) || (Token == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -565,6 +568,24 @@ EfiHttpRequest (
     }
   }
 
+  if (Configure && !ReConfigure &&
+      ((Request->Method == HttpMethodGet) || (Request->Method == HttpMethodHead)))
+  {
+    //
+    // Reuse an idle connection to the same server left by another HTTP instance.
+    // The server may have closed it meanwhile, and only idempotent requests can
+    // be resent on a new connection when that happens.
+    //
+    Status = HttpConnectionPoolGet (HttpInstance, HostName, RemotePort);
+    if (!EFI_ERROR (Status)) {
+      HttpInstance->RemotePort = RemotePort;
+      HttpInstance->RemoteHost = HostName;
+      HostName                 = NULL;
+      Configure                = FALSE;
+      Pooled                   = TRUE;
+    }
+  }
+
   if (Configure) {
     //
     // Parse Url for IPv4 or IPv6 address, if failed, perform DNS resolution.
@@ -756,7 +777,30 @@ EfiHttpRequest (
     }
   }
 
-  HttpInstance->ConnectionClose = FALSE;
+  if (Request != NULL) {
+    //
+    // Only a single GET or HEAD request sent on a pooled connection can be
+    // sent again on a new connection, so drop the copy of the previous one.
+    //
+    if (HttpInstance->RetryRequest != NULL) {
+      FreePool (HttpInstance->RetryRequest);
+      HttpInstance->RetryRequest = NULL;
+    }
+
+    if (Pooled && ((Request->Method == HttpMethodGet) || (Request->Method == HttpMethodHead))) {
+      HttpInstance->RetryRequest     = AllocateCopyPool (RequestMsgSize, RequestMsg);
+      HttpInstance->RetryRequestSize = RequestMsgSize;
+    }
+
+    HttpInstance->PendingResponses++;
+  }
+
+  //
+  // A request asking the server to close the connection after the response
+  // also keeps the connection from being reused or pooled here.
+  //
+  ConnectionHeader              = HttpFindHeader (HttpMsg->HeaderCount, HttpMsg->Headers, "Connection");
+  HttpInstance->ConnectionClose = (BOOLEAN)((ConnectionHeader != NULL) && (AsciiStriCmp (ConnectionHeader->FieldValue, "close") == 0));
 
   //
   // Transmit the request message.
@@ -1197,6 +1241,26 @@ HttpResponseWorker (
 
     gBS->SetTimer (HttpInstance->TimeoutEvent, TimerCancel, 0);
 
+    if (EFI_ERROR (Status) && (Status != EFI_TIMEOUT) && (HttpHeaders == NULL) && (HttpInstance->RetryRequest != NULL)) {
+      //
+      // The server closed the pooled connection before it received the
+      // request, send the request again on a new connection.
+      //
+      Status = HttpResendRequest (HttpInstance);
+      if (!EFI_ERROR (Status)) {
+        Status = gBS->SetTimer (HttpInstance->TimeoutEvent, TimerRelative, TimeoutValue * TICKS_PER_MS);
+        if (!EFI_ERROR (Status)) {
+          Status = HttpTcpReceiveHeader (HttpInstance, &SizeofHeaders, &BufferSize, HttpInstance->TimeoutEvent);
+          gBS->SetTimer (HttpInstance->TimeoutEvent, TimerCancel, 0);
+        }
+      }
+    }
+
+    if (HttpInstance->RetryRequest != NULL) {
+      FreePool (HttpInstance->RetryRequest);
+      HttpInstance->RetryRequest = NULL;
+    }
+
     if (EFI_ERROR (Status)) {
       goto Error;
     }
@@ -1374,6 +1438,7 @@ HttpResponseWorker (
         //
         HttpFreeMsgParser (HttpInstance->MsgParser);
         HttpInstance->MsgParser = NULL;
+        HttpResponseComplete (HttpInstance);
       }
     }
 
@@ -1528,6 +1593,7 @@ HttpResponseWorker (
       //
       HttpFreeMsgParser (HttpInstance->MsgParser);
       HttpInstance->MsgParser = NULL;
+      HttpResponseComplete (HttpInstance);
     }
 
     //
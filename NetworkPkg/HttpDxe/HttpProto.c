@@ -214,6 +214,7 @@ HttpTcpReceiveNotifyDpc (
     //
     HttpFreeMsgParser (HttpInstance->MsgParser);
     HttpInstance->MsgParser = NULL;
+    HttpResponseComplete (HttpInstance);
   }
 
   Wrap->HttpToken->Message->BodyLength = Length;
@@ -822,7 +823,19 @@ HttpCleanProtocol (
   IN  HTTP_PROTOCOL  *HttpInstance
   )
 {
-  HttpCloseConnection (HttpInstance);
+  if (HttpInstance->UseHttps) {
+    TlsSaveSessionId (HttpInstance);
+  }
+
+  if (!HttpConnectionPoolPut (HttpInstance)) {
+    HttpCloseConnection (HttpInstance);
+  }
+
+  HttpInstance->PendingResponses = 0;
+  if (HttpInstance->RetryRequest != NULL) {
+    FreePool (HttpInstance->RetryRequest);
+    HttpInstance->RetryRequest = NULL;
+  }
 
   HttpCloseTcpConnCloseEvent (HttpInstance);
 
@@ -944,6 +957,712 @@ HttpCleanProtocol (
   TlsCloseTxRxEvent (HttpInstance);
 }
 
+/**
+  Close a pooled connection and release its resources.
+
+  @param[in]  HttpService        The HTTP service owning the pool.
+  @param[in]  Connection         The pooled connection, already removed from the pool.
+
+**/
+STATIC
+VOID
+HttpConnectionPoolFree (
+  IN  HTTP_SERVICE            *HttpService,
+  IN  HTTP_POOLED_CONNECTION  *Connection
+  )
+{
+  //
+  // Destroying the TCP child aborts the connection.
+  //
+  if (!Connection->LocalAddressIsIPv6) {
+    gBS->CloseProtocol (
+           Connection->TcpChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip4DriverBindingHandle,
+      &gEfiTcp4ServiceBindingProtocolGuid,
+      Connection->TcpChildHandle
+      );
+  } else {
+    gBS->CloseProtocol (
+           Connection->TcpChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip6DriverBindingHandle,
+      &gEfiTcp6ServiceBindingProtocolGuid,
+      Connection->TcpChildHandle
+      );
+  }
+
+  gBS->CloseEvent (Connection->IdleTimeoutEvent);
+  FreePool (Connection->RemoteHost);
+  FreePool (Connection);
+}
+
+/**
+  Close the pooled connections that have been idle for too long.
+
+  @param[in]  HttpService        The HTTP service owning the pool.
+
+**/
+STATIC
+VOID
+HttpConnectionPoolExpire (
+  IN  HTTP_SERVICE  *HttpService
+  )
+{
+  LIST_ENTRY              *Entry;
+  LIST_ENTRY              *Next;
+  HTTP_POOLED_CONNECTION  *Connection;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->ConnectionPool) {
+    Connection = NET_LIST_USER_STRUCT (Entry, HTTP_POOLED_CONNECTION, Link);
+    if (gBS->CheckEvent (Connection->IdleTimeoutEvent) == EFI_SUCCESS) {
+      RemoveEntryList (&Connection->Link);
+      HttpService->ConnectionPoolCount--;
+      HttpService->ConnectionPoolEvictions++;
+      HttpConnectionPoolFree (HttpService, Connection);
+    }
+  }
+}
+
+/**
+  Keep the TCP connection of an HTTP instance that is being cleaned up in the
+  connection pool of its service, so that another HTTP instance can reuse it.
+
+  @param[in]  HttpInstance       The HTTP instance being cleaned up.
+
+  @retval TRUE                   The TCP child was moved to the pool.
+  @retval FALSE                  The connection cannot be reused.
+
+**/
+BOOLEAN
+HttpConnectionPoolPut (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  EFI_STATUS                 Status;
+  HTTP_SERVICE               *HttpService;
+  HTTP_POOLED_CONNECTION     *Connection;
+  EFI_TCP4_CONNECTION_STATE  Tcp4State;
+  EFI_TCP6_CONNECTION_STATE  Tcp6State;
+  EFI_TPL                    OldTpl;
+
+  HttpService = HttpInstance->Service;
+
+  //
+  // Only keep a plain HTTP connection whose responses were all read completely,
+  // the next user would get the rest of them otherwise. The message parser is
+  // only there while a response body is read, so it cannot tell whether the
+  // response to a request that was sent has started yet.
+  //
+  if ((PcdGet32 (PcdHttpConnectionPoolSize) == 0) ||
+      (HttpInstance->State != HTTP_STATE_TCP_CONNECTED) ||
+      (HttpInstance->PendingResponses != 0) ||
+      HttpInstance->UseHttps ||
+      HttpInstance->ProxyConnected ||
+      HttpInstance->ConnectionClose ||
+      (HttpInstance->RemoteHost == NULL) ||
+      (HttpInstance->CacheBody != NULL) ||
+      ((HttpInstance->MsgParser != NULL) && !HttpIsMessageComplete (HttpInstance->MsgParser)) ||
+      (NetMapGetCount (&HttpInstance->TxTokens) != 0) ||
+      (NetMapGetCount (&HttpInstance->RxTokens) != 0))
+  {
+    return FALSE;
+  }
+
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    Status = HttpInstance->Tcp4->GetModeData (HttpInstance->Tcp4, &Tcp4State, NULL, NULL, NULL, NULL);
+    if (EFI_ERROR (Status) || (Tcp4State != Tcp4StateEstablished)) {
+      return FALSE;
+    }
+  } else {
+    Status = HttpInstance->Tcp6->GetModeData (HttpInstance->Tcp6, &Tcp6State, NULL, NULL, NULL, NULL);
+    if (EFI_ERROR (Status) || (Tcp6State != Tcp6StateEstablished)) {
+      return FALSE;
+    }
+  }
+
+  Connection = AllocateZeroPool (sizeof (HTTP_POOLED_CONNECTION));
+  if (Connection == NULL) {
+    return FALSE;
+  }
+
+  Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &Connection->IdleTimeoutEvent);
+  if (EFI_ERROR (Status)) {
+    FreePool (Connection);
+    return FALSE;
+  }
+
+  gBS->SetTimer (
+         Connection->IdleTimeoutEvent,
+         TimerRelative,
+         MultU64x32 (PcdGet32 (PcdHttpConnectionPoolIdleTimeout), TICKS_PER_SECOND)
+         );
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  HttpConnectionPoolExpire (HttpService);
+  if (HttpService->ConnectionPoolCount >= PcdGet32 (PcdHttpConnectionPoolSize)) {
+    //
+    // Make room by closing the oldest connection.
+    //
+    ASSERT (!IsListEmpty (&HttpService->ConnectionPool));
+    HttpService->ConnectionPoolCount--;
+    HttpService->ConnectionPoolEvictions++;
+    HttpConnectionPoolFree (
+      HttpService,
+      NET_LIST_USER_STRUCT (NetListRemoveHead (&HttpService->ConnectionPool), HTTP_POOLED_CONNECTION, Link)
+      );
+  }
+
+  //
+  // The TCP child stays opened BY_DRIVER for the controller, only the opening
+  // by the HTTP child is closed. Pending tokens reference the HTTP instance.
+  //
+  Connection->LocalAddressIsIPv6 = HttpInstance->LocalAddressIsIPv6;
+  Connection->RemoteHost         = HttpInstance->RemoteHost;
+  Connection->RemotePort         = HttpInstance->RemotePort;
+  HttpInstance->RemoteHost       = NULL;
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    HttpInstance->Tcp4->Cancel (HttpInstance->Tcp4, NULL);
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpInstance->Handle
+           );
+    CopyMem (&Connection->IPv4Node, &HttpInstance->IPv4Node, sizeof (Connection->IPv4Node));
+    IP4_COPY_ADDRESS (&Connection->RemoteAddr, &HttpInstance->RemoteAddr);
+    Connection->TcpChildHandle    = HttpInstance->Tcp4ChildHandle;
+    HttpInstance->Tcp4ChildHandle = NULL;
+    HttpInstance->Tcp4            = NULL;
+  } else {
+    HttpInstance->Tcp6->Cancel (HttpInstance->Tcp6, NULL);
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpInstance->Handle
+           );
+    CopyMem (&Connection->Ipv6Node, &HttpInstance->Ipv6Node, sizeof (Connection->Ipv6Node));
+    IP6_COPY_ADDRESS (&Connection->RemoteIpv6Addr, &HttpInstance->RemoteIpv6Addr);
+    Connection->TcpChildHandle    = HttpInstance->Tcp6ChildHandle;
+    HttpInstance->Tcp6ChildHandle = NULL;
+    HttpInstance->Tcp6            = NULL;
+  }
+
+  InsertTailList (&HttpService->ConnectionPool, &Connection->Link);
+  HttpService->ConnectionPoolCount++;
+  HttpInstance->State = HTTP_STATE_TCP_CLOSED;
+
+  gBS->RestoreTPL (OldTpl);
+  return TRUE;
+}
+
+/**
+  Take an idle connection to the given server from the connection pool, and
+  use it in place of the TCP child of the HTTP instance.
+
+  @param[in]  HttpInstance       The HTTP instance, configured but not connected yet.
+  @param[in]  RemoteHost         The host name of the server.
+  @param[in]  RemotePort         The port of the server.
+
+  @retval EFI_SUCCESS            The HTTP instance is connected with a pooled connection.
+  @retval EFI_NOT_FOUND          There is no usable pooled connection.
+  @retval Others                 Other error as indicated.
+
+**/
+EFI_STATUS
+HttpConnectionPoolGet (
+  IN  HTTP_PROTOCOL  *HttpInstance,
+  IN  CHAR8          *RemoteHost,
+  IN  UINT16         RemotePort
+  )
+{
+  EFI_STATUS                 Status;
+  HTTP_SERVICE               *HttpService;
+  HTTP_POOLED_CONNECTION     *Connection;
+  LIST_ENTRY                 *Entry;
+  LIST_ENTRY                 *Next;
+  EFI_TCP4_PROTOCOL          *Tcp4;
+  EFI_TCP6_PROTOCOL          *Tcp6;
+  EFI_TCP4_CONNECTION_STATE  Tcp4State;
+  EFI_TCP6_CONNECTION_STATE  Tcp6State;
+  EFI_TPL                    OldTpl;
+
+  HttpService = HttpInstance->Service;
+
+  if ((PcdGet32 (PcdHttpConnectionPoolSize) == 0) ||
+      (HttpInstance->State != HTTP_STATE_HTTP_CONFIGED) ||
+      HttpInstance->UseHttps ||
+      HttpInstance->ProxyConnected)
+  {
+    return EFI_NOT_FOUND;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  HttpConnectionPoolExpire (HttpService);
+
+  Connection = NULL;
+  Tcp4       = NULL;
+  Tcp6       = NULL;
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->ConnectionPool) {
+    Connection = NET_LIST_USER_STRUCT (Entry, HTTP_POOLED_CONNECTION, Link);
+    if ((Connection->LocalAddressIsIPv6 != HttpInstance->LocalAddressIsIPv6) ||
+        (Connection->RemotePort != RemotePort) ||
+        (AsciiStrCmp (Connection->RemoteHost, RemoteHost) != 0) ||
+        (!HttpInstance->LocalAddressIsIPv6 &&
+         (CompareMem (&Connection->IPv4Node, &HttpInstance->IPv4Node, sizeof (Connection->IPv4Node)) != 0)) ||
+        (HttpInstance->LocalAddressIsIPv6 &&
+         (CompareMem (&Connection->Ipv6Node, &HttpInstance->Ipv6Node, sizeof (Connection->Ipv6Node)) != 0)))
+    {
+      Connection = NULL;
+      continue;
+    }
+
+    RemoveEntryList (&Connection->Link);
+    HttpService->ConnectionPoolCount--;
+
+    //
+    // Open the pooled TCP child for the HTTP child, and check that the server
+    // has not closed the connection in the meantime.
+    //
+    if (!HttpInstance->LocalAddressIsIPv6) {
+      Status = gBS->OpenProtocol (
+                      Connection->TcpChildHandle,
+                      &gEfiTcp4ProtocolGuid,
+                      (VOID **)&Tcp4,
+                      HttpService->Ip4DriverBindingHandle,
+                      HttpInstance->Handle,
+                      EFI_OPEN_PROTOCOL_BY_CHILD_CONTROLLER
+                      );
+      if (!EFI_ERROR (Status)) {
+        Status = Tcp4->GetModeData (Tcp4, &Tcp4State, NULL, NULL, NULL, NULL);
+        if (!EFI_ERROR (Status) && (Tcp4State == Tcp4StateEstablished)) {
+          break;
+        }
+
+        gBS->CloseProtocol (
+               Connection->TcpChildHandle,
+               &gEfiTcp4ProtocolGuid,
+               HttpService->Ip4DriverBindingHandle,
+               HttpInstance->Handle
+               );
+      }
+    } else {
+      Status = gBS->OpenProtocol (
+                      Connection->TcpChildHandle,
+                      &gEfiTcp6ProtocolGuid,
+                      (VOID **)&Tcp6,
+                      HttpService->Ip6DriverBindingHandle,
+                      HttpInstance->Handle,
+                      EFI_OPEN_PROTOCOL_BY_CHILD_CONTROLLER
+                      );
+      if (!EFI_ERROR (Status)) {
+        Status = Tcp6->GetModeData (Tcp6, &Tcp6State, NULL, NULL, NULL, NULL);
+        if (!EFI_ERROR (Status) && (Tcp6State == Tcp6StateEstablished)) {
+          break;
+        }
+
+        gBS->CloseProtocol (
+               Connection->TcpChildHandle,
+               &gEfiTcp6ProtocolGuid,
+               HttpService->Ip6DriverBindingHandle,
+               HttpInstance->Handle
+               );
+      }
+    }
+
+    HttpService->ConnectionPoolEvictions++;
+    HttpConnectionPoolFree (HttpService, Connection);
+    Connection = NULL;
+  }
+
+  if (Connection == NULL) {
+    HttpService->ConnectionPoolMisses++;
+    gBS->RestoreTPL (OldTpl);
+    return EFI_NOT_FOUND;
+  }
+
+  HttpService->ConnectionPoolHits++;
+  gBS->RestoreTPL (OldTpl);
+
+  DEBUG ((
+    DEBUG_INFO,
+    "HttpConnectionPoolGet: Reuse connection to %a:%d, hits %d, misses %d, evictions %d\n",
+    RemoteHost,
+    RemotePort,
+    HttpService->ConnectionPoolHits,
+    HttpService->ConnectionPoolMisses,
+    HttpService->ConnectionPoolEvictions
+    ));
+
+  //
+  // Replace the unconnected TCP child created by HttpInitProtocol() with the
+  // pooled one.
+  //
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp4ChildHandle,
+           &gEfiTcp4ProtocolGuid,
+           HttpService->Ip4DriverBindingHandle,
+           HttpInstance->Handle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip4DriverBindingHandle,
+      &gEfiTcp4ServiceBindingProtocolGuid,
+      HttpInstance->Tcp4ChildHandle
+      );
+
+    HttpInstance->Tcp4ChildHandle = Connection->TcpChildHandle;
+    HttpInstance->Tcp4            = Tcp4;
+    IP4_COPY_ADDRESS (&HttpInstance->RemoteAddr, &Connection->RemoteAddr);
+  } else {
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpService->ControllerHandle
+           );
+
+    gBS->CloseProtocol (
+           HttpInstance->Tcp6ChildHandle,
+           &gEfiTcp6ProtocolGuid,
+           HttpService->Ip6DriverBindingHandle,
+           HttpInstance->Handle
+           );
+
+    NetLibDestroyServiceChild (
+      HttpService->ControllerHandle,
+      HttpService->Ip6DriverBindingHandle,
+      &gEfiTcp6ServiceBindingProtocolGuid,
+      HttpInstance->Tcp6ChildHandle
+      );
+
+    HttpInstance->Tcp6ChildHandle = Connection->TcpChildHandle;
+    HttpInstance->Tcp6            = Tcp6;
+    IP6_COPY_ADDRESS (&HttpInstance->RemoteIpv6Addr, &Connection->RemoteIpv6Addr);
+  }
+
+  gBS->CloseEvent (Connection->IdleTimeoutEvent);
+  FreePool (Connection->RemoteHost);
+  FreePool (Connection);
+
+  Status = HttpCreateTcpConnCloseEvent (HttpInstance);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  HttpInstance->State = HTTP_STATE_TCP_CONNECTED;
+  return EFI_SUCCESS;
+}
+
+/**
+  Send the request saved in RetryRequest again on a new connection, after the
+  pooled connection it was sent on failed before any response data arrived.
+
+  The TCP child is reset and connected again with its current configuration,
+  and the request is sent synchronously. RetryRequest is left to the caller.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+  @retval EFI_SUCCESS            The request is sent on a new connection.
+  @retval Others                 Other error as indicated.
+
+**/
+EFI_STATUS
+HttpResendRequest (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  EFI_STATUS              Status;
+  EFI_TCP4_CONFIG_DATA    Tcp4CfgData;
+  EFI_TCP4_OPTION         Tcp4Option;
+  EFI_TCP4_IO_TOKEN       Tx4Token;
+  EFI_TCP4_TRANSMIT_DATA  Tx4Data;
+  EFI_TCP4_IO_TOKEN       *Rx4Token;
+  EFI_TCP6_CONFIG_DATA    Tcp6CfgData;
+  EFI_TCP6_OPTION         Tcp6Option;
+  EFI_TCP6_IO_TOKEN       Tx6Token;
+  EFI_TCP6_TRANSMIT_DATA  Tx6Data;
+  EFI_TCP6_IO_TOKEN       *Rx6Token;
+  EFI_EVENT               TxEvent;
+
+  ASSERT (HttpInstance->RetryRequest != NULL);
+  ASSERT (!HttpInstance->UseHttps);
+
+  DEBUG ((
+    DEBUG_INFO,
+    "HttpResendRequest: Pooled connection to %a:%d failed, send the request on a new connection\n",
+    HttpInstance->RemoteHost,
+    HttpInstance->RemotePort
+    ));
+  HttpInstance->Service->ConnectionPoolRetries++;
+
+  Status = gBS->CreateEvent (0, 0, NULL, NULL, &TxEvent);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (!HttpInstance->LocalAddressIsIPv6) {
+    //
+    // Reset the TCP child, which also flushes the failed header receive token,
+    // and connect it again.
+    //
+    Tcp4CfgData.ControlOption = &Tcp4Option;
+    Status                    = HttpInstance->Tcp4->GetModeData (HttpInstance->Tcp4, NULL, &Tcp4CfgData, NULL, NULL, NULL);
+    if (!EFI_ERROR (Status)) {
+      HttpInstance->Tcp4->Configure (HttpInstance->Tcp4, NULL);
+      HttpInstance->State = HTTP_STATE_TCP_UNCONFIGED;
+      Status              = HttpInstance->Tcp4->Configure (HttpInstance->Tcp4, &Tcp4CfgData);
+    }
+
+    Rx4Token = &HttpInstance->Rx4Token;
+    if (Rx4Token->CompletionToken.Event != NULL) {
+      gBS->CloseEvent (Rx4Token->CompletionToken.Event);
+      Rx4Token->CompletionToken.Event = NULL;
+    }
+
+    if ((Rx4Token->Packet.RxData != NULL) && (Rx4Token->Packet.RxData->FragmentTable[0].FragmentBuffer != NULL)) {
+      FreePool (Rx4Token->Packet.RxData->FragmentTable[0].FragmentBuffer);
+      Rx4Token->Packet.RxData->FragmentTable[0].FragmentBuffer = NULL;
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    HttpInstance->State = HTTP_STATE_TCP_CONFIGED;
+    Status              = HttpCreateConnection (HttpInstance);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Tx4Data.Push                            = TRUE;
+    Tx4Data.Urgent                          = FALSE;
+    Tx4Data.DataLength                      = (UINT32)HttpInstance->RetryRequestSize;
+    Tx4Data.FragmentCount                   = 1;
+    Tx4Data.FragmentTable[0].FragmentLength = (UINT32)HttpInstance->RetryRequestSize;
+    Tx4Data.FragmentTable[0].FragmentBuffer = HttpInstance->RetryRequest;
+    Tx4Token.Packet.TxData                  = &Tx4Data;
+    Tx4Token.CompletionToken.Event          = TxEvent;
+    Tx4Token.CompletionToken.Status         = EFI_NOT_READY;
+
+    Status = HttpInstance->Tcp4->Transmit (HttpInstance->Tcp4, &Tx4Token);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    while (gBS->CheckEvent (TxEvent) == EFI_NOT_READY) {
+      HttpInstance->Tcp4->Poll (HttpInstance->Tcp4);
+    }
+
+    Status = Tx4Token.CompletionToken.Status;
+  } else {
+    Tcp6CfgData.ControlOption = &Tcp6Option;
+    Status                    = HttpInstance->Tcp6->GetModeData (HttpInstance->Tcp6, NULL, &Tcp6CfgData, NULL, NULL, NULL);
+    if (!EFI_ERROR (Status)) {
+      HttpInstance->Tcp6->Configure (HttpInstance->Tcp6, NULL);
+      HttpInstance->State = HTTP_STATE_TCP_UNCONFIGED;
+      Status              = HttpInstance->Tcp6->Configure (HttpInstance->Tcp6, &Tcp6CfgData);
+    }
+
+    Rx6Token = &HttpInstance->Rx6Token;
+    if (Rx6Token->CompletionToken.Event != NULL) {
+      gBS->CloseEvent (Rx6Token->CompletionToken.Event);
+      Rx6Token->CompletionToken.Event = NULL;
+    }
+
+    if ((Rx6Token->Packet.RxData != NULL) && (Rx6Token->Packet.RxData->FragmentTable[0].FragmentBuffer != NULL)) {
+      FreePool (Rx6Token->Packet.RxData->FragmentTable[0].FragmentBuffer);
+      Rx6Token->Packet.RxData->FragmentTable[0].FragmentBuffer = NULL;
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    HttpInstance->State = HTTP_STATE_TCP_CONFIGED;
+    Status              = HttpCreateConnection (HttpInstance);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    Tx6Data.Push                            = TRUE;
+    Tx6Data.Urgent                          = FALSE;
+    Tx6Data.DataLength                      = (UINT32)HttpInstance->RetryRequestSize;
+    Tx6Data.FragmentCount                   = 1;
+    Tx6Data.FragmentTable[0].FragmentLength = (UINT32)HttpInstance->RetryRequestSize;
+    Tx6Data.FragmentTable[0].FragmentBuffer = HttpInstance->RetryRequest;
+    Tx6Token.Packet.TxData                  = &Tx6Data;
+    Tx6Token.CompletionToken.Event          = TxEvent;
+    Tx6Token.CompletionToken.Status         = EFI_NOT_READY;
+
+    Status = HttpInstance->Tcp6->Transmit (HttpInstance->Tcp6, &Tx6Token);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+
+    while (gBS->CheckEvent (TxEvent) == EFI_NOT_READY) {
+      HttpInstance->Tcp6->Poll (HttpInstance->Tcp6);
+    }
+
+    Status = Tx6Token.CompletionToken.Status;
+  }
+
+  if (!EFI_ERROR (Status)) {
+    HttpInstance->PendingResponses = 1;
+  }
+
+ON_EXIT:
+  gBS->CloseEvent (TxEvent);
+  return Status;
+}
+
+/**
+  Account for a response that was received completely.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+HttpResponseComplete (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  if (HttpInstance->PendingResponses > 0) {
+    HttpInstance->PendingResponses--;
+  }
+}
+
+/**
+  Get the statistics of the HTTP connection pool.
+
+  @param[in]  This        The EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL instance.
+  @param[out] Statistics  The statistics of the connection pool.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  This or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+HttpConnectionPoolGetStatistics (
+  IN  EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_HTTP_CONNECTION_POOL_STATISTICS           *Statistics
+  )
+{
+  HTTP_SERVICE  *HttpService;
+  EFI_TPL       OldTpl;
+
+  if ((This == NULL) || (Statistics == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  HttpService = HTTP_SERVICE_FROM_POOL_STATISTICS (This);
+
+  OldTpl                = gBS->RaiseTPL (TPL_CALLBACK);
+  Statistics->IdleCount = HttpService->ConnectionPoolCount;
+  Statistics->Hits      = HttpService->ConnectionPoolHits;
+  Statistics->Misses    = HttpService->ConnectionPoolMisses;
+  Statistics->Evictions = HttpService->ConnectionPoolEvictions;
+  Statistics->Retries   = HttpService->ConnectionPoolRetries;
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Clear the counters of the HTTP connection pool. The idle connections are kept.
+
+  @param[in] This  The EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS            The counters are cleared.
+  @retval EFI_INVALID_PARAMETER  This is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+HttpConnectionPoolResetStatistics (
+  IN EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL  *This
+  )
+{
+  HTTP_SERVICE  *HttpService;
+  EFI_TPL       OldTpl;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  HttpService = HTTP_SERVICE_FROM_POOL_STATISTICS (This);
+
+  OldTpl                               = gBS->RaiseTPL (TPL_CALLBACK);
+  HttpService->ConnectionPoolHits      = 0;
+  HttpService->ConnectionPoolMisses    = 0;
+  HttpService->ConnectionPoolEvictions = 0;
+  HttpService->ConnectionPoolRetries   = 0;
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Close all the pooled connections of one IP version.
+
+  @param[in]  HttpService        The HTTP service.
+  @param[in]  UsingIpv6          TRUE to close the TCP6 connections, FALSE for TCP4.
+
+**/
+VOID
+HttpConnectionPoolFlush (
+  IN  HTTP_SERVICE  *HttpService,
+  IN  BOOLEAN       UsingIpv6
+  )
+{
+  LIST_ENTRY              *Entry;
+  LIST_ENTRY              *Next;
+  HTTP_POOLED_CONNECTION  *Connection;
+
+  DEBUG ((
+    DEBUG_INFO,
+    "HttpConnectionPoolFlush: %d connections, hits %d, misses %d, evictions %d\n",
+    HttpService->ConnectionPoolCount,
+    HttpService->ConnectionPoolHits,
+    HttpService->ConnectionPoolMisses,
+    HttpService->ConnectionPoolEvictions
+    ));
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &HttpService->ConnectionPool) {
+    Connection = NET_LIST_USER_STRUCT (Entry, HTTP_POOLED_CONNECTION, Link);
+    if (Connection->LocalAddressIsIPv6 == UsingIpv6) {
+      RemoveEntryList (&Connection->Link);
+      HttpService->ConnectionPoolCount--;
+      HttpConnectionPoolFree (HttpService, Connection);
+    }
+  }
+}
+
 /**
   Establish TCP connection with HTTP server.
 
@@ -996,7 +1715,8 @@ HttpCreateConnection (
   }
 
   if (!EFI_ERROR (Status)) {
-    HttpInstance->State = HTTP_STATE_TCP_CONNECTED;
+    HttpInstance->State            = HTTP_STATE_TCP_CONNECTED;
+    HttpInstance->PendingResponses = 0;
   }
 
   return Status;
@@ -1102,6 +1822,7 @@ HttpConfigureTcp4 (
   Tcp4Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp4Option->EnableNagle         = TRUE;
   Tcp4Option->EnableWindowScaling = TRUE;
+  Tcp4Option->EnableSelectiveAck  = TRUE;
   Tcp4CfgData->ControlOption      = Tcp4Option;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
@@ -1186,6 +1907,7 @@ HttpConfigureTcp6 (
   Tcp6Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp6Option->EnableNagle         = TRUE;
   Tcp6Option->EnableWindowScaling = TRUE;
+  Tcp6Option->EnableSelectiveAck  = TRUE;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
       (HttpInstance->State == HTTP_STATE_TCP_CLOSED))
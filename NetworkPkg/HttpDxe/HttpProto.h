@@ -24,6 +24,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
   HTTP_SERVICE_SIGNATURE \
   )
 
+#define HTTP_SERVICE_FROM_POOL_STATISTICS(a) \
+  CR ( \
+  (a), \
+  HTTP_SERVICE, \
+  ConnectionPoolStatistics, \
+  HTTP_SERVICE_SIGNATURE \
+  )
+
 //
 // The state of HTTP protocol. It starts from UNCONFIGED.
 //
@@ -50,18 +58,45 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define HTTP_URL_BUFFER_LEN  4096
 
 typedef struct _HTTP_SERVICE {
-  UINT32                          Signature;
-  EFI_SERVICE_BINDING_PROTOCOL    ServiceBinding;
-  EFI_HANDLE                      Ip4DriverBindingHandle;
-  EFI_HANDLE                      Ip6DriverBindingHandle;
-  EFI_HANDLE                      ControllerHandle;
-  EFI_HANDLE                      Tcp4ChildHandle;
-  EFI_HANDLE                      Tcp6ChildHandle;
-  LIST_ENTRY                      ChildrenList;
-  UINTN                           ChildrenNumber;
-  INTN                            State;
+  UINT32                                            Signature;
+  EFI_SERVICE_BINDING_PROTOCOL                      ServiceBinding;
+  EFI_HANDLE                                        Ip4DriverBindingHandle;
+  EFI_HANDLE                                        Ip6DriverBindingHandle;
+  EFI_HANDLE                                        ControllerHandle;
+  EFI_HANDLE                                        Tcp4ChildHandle;
+  EFI_HANDLE                                        Tcp6ChildHandle;
+  LIST_ENTRY                                        ChildrenList;
+  UINTN                                             ChildrenNumber;
+  INTN                                              State;
+
+  //
+  // Idle connections kept for reuse by other HTTP instances.
+  //
+  LIST_ENTRY                                        ConnectionPool;
+  UINTN                                             ConnectionPoolCount;
+  UINTN                                             ConnectionPoolHits;
+  UINTN                                             ConnectionPoolMisses;
+  UINTN                                             ConnectionPoolEvictions;
+  UINTN                                             ConnectionPoolRetries;
+  EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL    ConnectionPoolStatistics;
 } HTTP_SERVICE;
 
+//
+// An idle, connected TCP child kept in the connection pool of the service.
+//
+typedef struct {
+  LIST_ENTRY                 Link;
+  BOOLEAN                    LocalAddressIsIPv6;
+  EFI_HTTPv4_ACCESS_POINT    IPv4Node;
+  EFI_HTTPv6_ACCESS_POINT    Ipv6Node;
+  EFI_HANDLE                 TcpChildHandle;
+  CHAR8                      *RemoteHost;
+  UINT16                     RemotePort;
+  EFI_IPv4_ADDRESS           RemoteAddr;
+  EFI_IPv6_ADDRESS           RemoteIpv6Addr;
+  EFI_EVENT                  IdleTimeoutEvent;
+} HTTP_POOLED_CONNECTION;
+
 typedef struct {
   EFI_TCP4_IO_TOKEN         Tx4Token;
   EFI_TCP4_TRANSMIT_DATA    Tx4Data;
@@ -206,6 +241,20 @@ typedef struct _HTTP_PROTOCOL {
   BOOLEAN                           TlsIsRxDone;
 
   BOOLEAN                           ConnectionClose;
+
+  //
+  // The number of requests sent on the connection whose response has not
+  // been received completely. The connection is not pooled until it is 0.
+  //
+  UINTN                             PendingResponses;
+
+  //
+  // A copy of the first request sent on a connection taken from the pool,
+  // sent again on a new connection if the pooled one fails before any
+  // response data is received.
+  //
+  CHAR8                             *RetryRequest;
+  UINTN                             RetryRequestSize;
 } HTTP_PROTOCOL;
 
 typedef struct {
@@ -343,6 +392,112 @@ HttpCleanProtocol (
   IN  HTTP_PROTOCOL  *HttpInstance
   );
 
+/**
+  Keep the TCP connection of an HTTP instance that is being cleaned up in the
+  connection pool of its service, so that another HTTP instance can reuse it.
+
+  @param[in]  HttpInstance       The HTTP instance being cleaned up.
+
+  @retval TRUE                   The TCP child was moved to the pool.
+  @retval FALSE                  The connection cannot be reused.
+
+**/
+BOOLEAN
+HttpConnectionPoolPut (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  );
+
+/**
+  Take an idle connection to the given server from the connection pool, and
+  use it in place of the TCP child of the HTTP instance.
+
+  @param[in]  HttpInstance       The HTTP instance, configured but not connected yet.
+  @param[in]  RemoteHost         The host name of the server.
+  @param[in]  RemotePort         The port of the server.
+
+  @retval EFI_SUCCESS            The HTTP instance is connected with a pooled connection.
+  @retval EFI_NOT_FOUND          There is no usable pooled connection.
+  @retval Others                 Other error as indicated.
+
+**/
+EFI_STATUS
+HttpConnectionPoolGet (
+  IN  HTTP_PROTOCOL  *HttpInstance,
+  IN  CHAR8          *RemoteHost,
+  IN  UINT16         RemotePort
+  );
+
+/**
+  Close all the pooled connections of one IP version.
+
+  @param[in]  HttpService        The HTTP service.
+  @param[in]  UsingIpv6          TRUE to close the TCP6 connections, FALSE for TCP4.
+
+**/
+VOID
+HttpConnectionPoolFlush (
+  IN  HTTP_SERVICE  *HttpService,
+  IN  BOOLEAN       UsingIpv6
+  );
+
+/**
+  Send the request saved in RetryRequest again on a new connection, after the
+  pooled connection it was sent on failed before any response data arrived.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+  @retval EFI_SUCCESS            The request is sent on a new connection.
+  @retval Others                 Other error as indicated.
+
+**/
+EFI_STATUS
+HttpResendRequest (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  );
+
+/**
+  Account for a response that was received completely.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+HttpResponseComplete (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  );
+
+/**
+  Get the statistics of the HTTP connection pool.
+
+  @param[in]  This        The EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL instance.
+  @param[out] Statistics  The statistics of the connection pool.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  This or Statistics is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+HttpConnectionPoolGetStatistics (
+  IN  EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_HTTP_CONNECTION_POOL_STATISTICS           *Statistics
+  );
+
+/**
+  Clear the counters of the HTTP connection pool. The idle connections are kept.
+
+  @param[in] This  The EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS            The counters are cleared.
+  @retval EFI_INVALID_PARAMETER  This is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+HttpConnectionPoolResetStatistics (
+  IN EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL  *This
+  );
+
 /**
   Establish TCP connection with HTTP server.
 
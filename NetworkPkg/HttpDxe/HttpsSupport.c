@@ -10,6 +10,23 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "HttpDriver.h"
 
+//
+// The TLS session ID of an HTTPS server.
+//
+typedef struct {
+  LIST_ENTRY            Link;
+  CHAR8                 *HostName;
+  UINT16                Port;
+  EFI_TLS_SESSION_ID    SessionId;
+} HTTPS_SESSION_ID_ENTRY;
+
+//
+// The TLS session IDs of the recently used HTTPS servers, the least recently
+// used first.
+//
+LIST_ENTRY  mHttpsSessionIdList  = INITIALIZE_LIST_HEAD_VARIABLE (mHttpsSessionIdList);
+UINTN       mHttpsSessionIdCount = 0;
+
 /**
   Returns the first occurrence of a Null-terminated ASCII sub-string in a Null-terminated
   ASCII string and ignore case during the search process.
@@ -636,6 +653,111 @@ ON_EXIT:
   return Status;
 }
 
+/**
+  Find the saved TLS session ID of the server of an HTTP instance.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+  @return  The saved session ID entry, or NULL if there is none.
+
+**/
+STATIC
+HTTPS_SESSION_ID_ENTRY *
+TlsFindSessionId (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  LIST_ENTRY              *Entry;
+  HTTPS_SESSION_ID_ENTRY  *SessionIdEntry;
+
+  if (HttpInstance->TlsConfigData.VerifyHost.HostName == NULL) {
+    return NULL;
+  }
+
+  NET_LIST_FOR_EACH (Entry, &mHttpsSessionIdList) {
+    SessionIdEntry = NET_LIST_USER_STRUCT (Entry, HTTPS_SESSION_ID_ENTRY, Link);
+    if ((SessionIdEntry->Port == HttpInstance->RemotePort) &&
+        (AsciiStrCmp (SessionIdEntry->HostName, HttpInstance->TlsConfigData.VerifyHost.HostName) == 0))
+    {
+      return SessionIdEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Save the ID of the TLS session of an HTTP instance, so that later connections
+  to the same server can resume the session instead of doing a full handshake.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+TlsSaveSessionId (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  EFI_STATUS              Status;
+  EFI_TLS_SESSION_ID      SessionId;
+  UINTN                   SessionIdSize;
+  HTTPS_SESSION_ID_ENTRY  *SessionIdEntry;
+
+  if ((HttpInstance->Tls == NULL) || !HttpInstance->TlsAlreadyCreated ||
+      (HttpInstance->TlsSessionState != EfiTlsSessionDataTransferring))
+  {
+    return;
+  }
+
+  //
+  // With TLS 1.3, the session ID changes when the server sends a new session
+  // ticket after the handshake, so this is called again before the session is
+  // closed.
+  //
+  SessionIdSize = sizeof (SessionId);
+  Status        = HttpInstance->Tls->GetSessionData (
+                                       HttpInstance->Tls,
+                                       EfiTlsSessionID,
+                                       &SessionId,
+                                       &SessionIdSize
+                                       );
+  if (EFI_ERROR (Status) || (SessionId.Length == 0) || (SessionId.Length > MAX_TLS_SESSION_ID_LENGTH)) {
+    return;
+  }
+
+  SessionIdEntry = TlsFindSessionId (HttpInstance);
+  if (SessionIdEntry != NULL) {
+    RemoveEntryList (&SessionIdEntry->Link);
+  } else {
+    if (mHttpsSessionIdCount == HTTPS_SESSION_ID_MAX) {
+      SessionIdEntry = NET_LIST_USER_STRUCT (NetListRemoveHead (&mHttpsSessionIdList), HTTPS_SESSION_ID_ENTRY, Link);
+      FreePool (SessionIdEntry->HostName);
+      FreePool (SessionIdEntry);
+      mHttpsSessionIdCount--;
+    }
+
+    SessionIdEntry = AllocateZeroPool (sizeof (HTTPS_SESSION_ID_ENTRY));
+    if (SessionIdEntry == NULL) {
+      return;
+    }
+
+    SessionIdEntry->HostName = AllocateCopyPool (
+                                 AsciiStrSize (HttpInstance->TlsConfigData.VerifyHost.HostName),
+                                 HttpInstance->TlsConfigData.VerifyHost.HostName
+                                 );
+    if (SessionIdEntry->HostName == NULL) {
+      FreePool (SessionIdEntry);
+      return;
+    }
+
+    SessionIdEntry->Port = HttpInstance->RemotePort;
+    mHttpsSessionIdCount++;
+  }
+
+  CopyMem (&SessionIdEntry->SessionId, &SessionId, sizeof (SessionId));
+  InsertTailList (&mHttpsSessionIdList, &SessionIdEntry->Link);
+}
+
 /**
   Configure TLS session data.
 
@@ -651,7 +773,8 @@ TlsConfigureSession (
   IN OUT HTTP_PROTOCOL  *HttpInstance
   )
 {
-  EFI_STATUS  Status;
+  EFI_STATUS              Status;
+  HTTPS_SESSION_ID_ENTRY  *SessionIdEntry;
 
   //
   // TlsConfigData initialization
@@ -704,6 +827,21 @@ TlsConfigureSession (
     return Status;
   }
 
+  //
+  // Resume the previous TLS session with this server, if any. The TLS driver
+  // does a full handshake when it does not have the session anymore.
+  //
+  SessionIdEntry = TlsFindSessionId (HttpInstance);
+  if (SessionIdEntry != NULL) {
+    Status = HttpInstance->Tls->SetSessionData (
+                                  HttpInstance->Tls,
+                                  EfiTlsSessionID,
+                                  &SessionIdEntry->SessionId,
+                                  sizeof (EFI_TLS_SESSION_ID)
+                                  );
+    DEBUG ((DEBUG_INFO, "TlsConfigureSession: Resume TLS session with %a: %r\n", SessionIdEntry->HostName, Status));
+  }
+
   Status = HttpInstance->Tls->SetSessionData (
                                 HttpInstance->Tls,
                                 EfiTlsSessionState,
@@ -1422,6 +1560,8 @@ TlsConnectSession (
 
   if (HttpInstance->TlsSessionState != EfiTlsSessionDataTransferring) {
     Status = EFI_ABORTED;
+  } else {
+    TlsSaveSessionId (HttpInstance);
   }
 
   return Status;
@@ -1461,6 +1601,8 @@ TlsCloseSession (
     return EFI_INVALID_PARAMETER;
   }
 
+  TlsSaveSessionId (HttpInstance);
+
   HttpInstance->TlsSessionState = EfiTlsSessionClosing;
 
   Status = HttpInstance->Tls->SetSessionData (
@@ -14,6 +14,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define HTTPS_FLAG  "https://"
 
+//
+// Number of HTTPS servers whose TLS session ID is kept for resumption.
+//
+#define HTTPS_SESSION_ID_MAX  8
+
 /**
   Check whether the Url is from Https.
 
@@ -205,6 +210,18 @@ TlsCloseSession (
   IN  HTTP_PROTOCOL  *HttpInstance
   );
 
+/**
+  Save the ID of the TLS session of an HTTP instance, so that later connections
+  to the same server can resume the session instead of doing a full handshake.
+
+  @param[in]  HttpInstance       The HTTP instance private data.
+
+**/
+VOID
+TlsSaveSessionId (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  );
+
 /**
   Process one message according to the CryptMode.
 
@@ -1905,6 +1905,41 @@ NetbufCopy (
   IN UINT8    *Dest
   );
 
+/**
+  Get the number of bytes the net buffer functions have copied in this module.
+
+  Each network driver has its own instance of the library, so the count is the
+  copy cost of the layer the driver implements. It includes the data copied by
+  NetbufCopy(), NetbufDuplicate(), NetbufQueCopy() and the headers aggregated
+  by NetbufFromExt().
+
+  @return           The number of bytes copied.
+
+**/
+UINT64
+EFIAPI
+NetbufGetCopiedBytes (
+  VOID
+  );
+
+/**
+  Install the EDKII_NET_BUFFER_STATISTICS_PROTOCOL on the image handle of the
+  network driver, to report the count of NetbufGetCopiedBytes() of this module.
+
+  NetLibDefaultUnload() uninstalls the protocol when the driver is unloaded.
+
+  @param[in]  ImageHandle       The image handle of the network driver.
+
+  @retval EFI_SUCCESS           The protocol is installed.
+  @retval Others                Failed to install the protocol.
+
+**/
+EFI_STATUS
+EFIAPI
+NetbufInstallStatistics (
+  IN EFI_HANDLE  ImageHandle
+  );
+
 /**
   Build a NET_BUF from external blocks.
 
@@ -0,0 +1,93 @@
+/** @file
+  DPC Statistics Protocol is an EDK II-specific interface produced by DpcDxe
+  to report the activity of the Deferred Procedure Call queue of each TPL.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_DPC_STATISTICS_H_
+#define EDKII_DPC_STATISTICS_H_
+
+#define EDKII_DPC_STATISTICS_PROTOCOL_GUID \
+  { \
+    0x2b9c5e4a, 0x7d31, 0x4f86, { 0x9a, 0x0e, 0x53, 0xc1, 0x6f, 0x28, 0xb4, 0xd7 } \
+  }
+
+typedef struct _EDKII_DPC_STATISTICS_PROTOCOL EDKII_DPC_STATISTICS_PROTOCOL;
+
+///
+/// The statistics of the DPC queue of one TPL.
+///
+typedef struct {
+  ///
+  /// The number of DPCs queued.
+  ///
+  UINT64    QueuedCount;
+  ///
+  /// The number of DPCs dispatched.
+  ///
+  UINT64    DispatchedCount;
+  ///
+  /// The number of DPCs that could not be queued because the queue was full
+  /// and could not be grown.
+  ///
+  UINT64    FailedCount;
+  ///
+  /// The number of DPCs currently in the queue.
+  ///
+  UINT64    Depth;
+  ///
+  /// The largest number of DPCs that were in the queue at the same time.
+  ///
+  UINT64    MaxDepth;
+  ///
+  /// The number of DPCs the queue can hold before it has to be grown.
+  ///
+  UINT64    Capacity;
+} EDKII_DPC_STATISTICS;
+
+/**
+  Get the statistics of the DPC queue of a TPL.
+
+  @param[in]  This        The EDKII_DPC_STATISTICS_PROTOCOL instance.
+  @param[in]  DpcTpl      The EFI_TPL of the DPC queue.
+  @param[out] Statistics  The statistics of the DPC queue.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  DpcTpl is not a valid EFI_TPL.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_DPC_STATISTICS_GET)(
+  IN  EDKII_DPC_STATISTICS_PROTOCOL  *This,
+  IN  EFI_TPL                        DpcTpl,
+  OUT EDKII_DPC_STATISTICS           *Statistics
+  );
+
+/**
+  Clear the statistics of the DPC queues of all TPLs. The maximum depth of each
+  queue restarts from its current depth.
+
+  @param[in] This  The EDKII_DPC_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The statistics are cleared.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_DPC_STATISTICS_RESET)(
+  IN EDKII_DPC_STATISTICS_PROTOCOL  *This
+  );
+
+struct _EDKII_DPC_STATISTICS_PROTOCOL {
+  EDKII_DPC_STATISTICS_GET      GetStatistics;
+  EDKII_DPC_STATISTICS_RESET    Reset;
+};
+
+extern EFI_GUID  gEdkiiDpcStatisticsProtocolGuid;
+
+#endif
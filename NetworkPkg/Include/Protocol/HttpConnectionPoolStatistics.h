@@ -0,0 +1,88 @@
+/** @file
+  HTTP Connection Pool Statistics Protocol is an EDK II-specific interface
+  produced by HttpDxe to report how the idle HTTP connections kept for reuse
+  are used. It is installed on the handle of the HTTP service binding protocol.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_HTTP_CONNECTION_POOL_STATISTICS_H_
+#define EDKII_HTTP_CONNECTION_POOL_STATISTICS_H_
+
+#define EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL_GUID \
+  { \
+    0xe958c0ea, 0xc310, 0x42b7, { 0x96, 0x36, 0xf4, 0xa1, 0x1c, 0xe0, 0xce, 0x2f } \
+  }
+
+typedef struct _EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL;
+
+///
+/// The statistics of the HTTP connection pool of one network interface.
+///
+typedef struct {
+  ///
+  /// The number of idle connections currently in the pool.
+  ///
+  UINT64    IdleCount;
+  ///
+  /// The number of requests sent on a connection taken from the pool.
+  ///
+  UINT64    Hits;
+  ///
+  /// The number of times no usable connection to the server was in the pool.
+  ///
+  UINT64    Misses;
+  ///
+  /// The number of connections closed because the pool was full, they were
+  /// idle for too long, or the server had closed them.
+  ///
+  UINT64    Evictions;
+  ///
+  /// The number of requests sent again on a new connection, because the
+  /// connection taken from the pool failed before any response was received.
+  ///
+  UINT64    Retries;
+} EDKII_HTTP_CONNECTION_POOL_STATISTICS;
+
+/**
+  Get the statistics of the HTTP connection pool.
+
+  @param[in]  This        The EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL instance.
+  @param[out] Statistics  The statistics of the connection pool.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  This or Statistics is NULL.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_HTTP_CONNECTION_POOL_STATISTICS_GET)(
+  IN  EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_HTTP_CONNECTION_POOL_STATISTICS           *Statistics
+  );
+
+/**
+  Clear the counters of the HTTP connection pool. The idle connections are kept.
+
+  @param[in] This  The EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS            The counters are cleared.
+  @retval EFI_INVALID_PARAMETER  This is NULL.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_HTTP_CONNECTION_POOL_STATISTICS_RESET)(
+  IN EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL  *This
+  );
+
+struct _EDKII_HTTP_CONNECTION_POOL_STATISTICS_PROTOCOL {
+  EDKII_HTTP_CONNECTION_POOL_STATISTICS_GET      GetStatistics;
+  EDKII_HTTP_CONNECTION_POOL_STATISTICS_RESET    Reset;
+};
+
+extern EFI_GUID  gEdkiiHttpConnectionPoolStatisticsProtocolGuid;
+
+#endif
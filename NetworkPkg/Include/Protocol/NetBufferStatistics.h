@@ -0,0 +1,73 @@
+/** @file
+  Net Buffer Statistics Protocol is an EDK II-specific interface installed on
+  the image handle of a network driver, to report how many bytes the net buffer
+  functions of that driver have copied.
+
+  Each network driver links its own instance of NetLib, so each instance of the
+  protocol reports the copy cost of one network layer.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_NET_BUFFER_STATISTICS_H_
+#define EDKII_NET_BUFFER_STATISTICS_H_
+
+#define EDKII_NET_BUFFER_STATISTICS_PROTOCOL_GUID \
+  { \
+    0xd1cf3ce1, 0xbcfa, 0x495b, { 0xb2, 0xc4, 0xc6, 0xa4, 0x8b, 0x3c, 0xc0, 0x17 } \
+  }
+
+typedef struct _EDKII_NET_BUFFER_STATISTICS_PROTOCOL EDKII_NET_BUFFER_STATISTICS_PROTOCOL;
+
+///
+/// The statistics of the net buffers of one network driver.
+///
+typedef struct {
+  ///
+  /// The number of bytes copied by NetbufCopy(), NetbufDuplicate() and
+  /// NetbufQueCopy(), plus the headers aggregated by NetbufFromExt().
+  ///
+  UINT64    CopiedBytes;
+} EDKII_NET_BUFFER_STATISTICS;
+
+/**
+  Get the statistics of the net buffers of the network driver.
+
+  @param[in]  This        The EDKII_NET_BUFFER_STATISTICS_PROTOCOL instance.
+  @param[out] Statistics  The statistics of the net buffers.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_NET_BUFFER_STATISTICS_GET)(
+  IN  EDKII_NET_BUFFER_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_NET_BUFFER_STATISTICS           *Statistics
+  );
+
+/**
+  Clear the statistics of the net buffers of the network driver.
+
+  @param[in] This  The EDKII_NET_BUFFER_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The statistics are cleared.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_NET_BUFFER_STATISTICS_RESET)(
+  IN EDKII_NET_BUFFER_STATISTICS_PROTOCOL  *This
+  );
+
+struct _EDKII_NET_BUFFER_STATISTICS_PROTOCOL {
+  EDKII_NET_BUFFER_STATISTICS_GET      GetStatistics;
+  EDKII_NET_BUFFER_STATISTICS_RESET    Reset;
+};
+
+extern EFI_GUID  gEdkiiNetBufferStatisticsProtocolGuid;
+
+#endif
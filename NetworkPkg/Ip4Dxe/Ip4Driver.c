@@ -75,7 +75,8 @@ Ip4DriverEntryPoint (
   IN EFI_SYSTEM_TABLE  *SystemTable
   )
 {
-  VOID  *Registration;
+  EFI_STATUS  Status;
+  VOID        *Registration;
 
   EfiCreateProtocolNotifyEvent (
     &gEfiIpSec2ProtocolGuid,
@@ -85,14 +86,19 @@ Ip4DriverEntryPoint (
     &Registration
     );
 
-  return EfiLibInstallDriverBindingComponentName2 (
-           ImageHandle,
-           SystemTable,
-           &gIp4DriverBinding,
-           ImageHandle,
-           &gIp4ComponentName,
-           &gIp4ComponentName2
-           );
+  Status = EfiLibInstallDriverBindingComponentName2 (
+             ImageHandle,
+             SystemTable,
+             &gIp4DriverBinding,
+             ImageHandle,
+             &gIp4ComponentName,
+             &gIp4ComponentName2
+             );
+  if (!EFI_ERROR (Status)) {
+    NetbufInstallStatistics (ImageHandle);
+  }
+
+  return Status;
 }
 
 /**
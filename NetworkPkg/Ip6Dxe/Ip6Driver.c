@@ -74,7 +74,8 @@ Ip6DriverEntryPoint (
   IN EFI_SYSTEM_TABLE  *SystemTable
   )
 {
-  VOID  *Registration;
+  EFI_STATUS  Status;
+  VOID        *Registration;
 
   EfiCreateProtocolNotifyEvent (
     &gEfiIpSec2ProtocolGuid,
@@ -84,14 +85,19 @@ Ip6DriverEntryPoint (
     &Registration
     );
 
-  return EfiLibInstallDriverBindingComponentName2 (
-           ImageHandle,
-           SystemTable,
-           &gIp6DriverBinding,
-           ImageHandle,
-           &gIp6ComponentName,
-           &gIp6ComponentName2
-           );
+  Status = EfiLibInstallDriverBindingComponentName2 (
+             ImageHandle,
+             SystemTable,
+             &gIp6DriverBinding,
+             ImageHandle,
+             &gIp6ComponentName,
+             &gIp6ComponentName2
+             );
+  if (!EFI_ERROR (Status)) {
+    NetbufInstallStatistics (ImageHandle);
+  }
+
+  return Status;
 }
 
 /**
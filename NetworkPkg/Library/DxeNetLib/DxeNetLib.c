@@ -19,6 +19,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/Ip4Config2.h>
 #include <Protocol/ComponentName.h>
 #include <Protocol/ComponentName2.h>
+#include <Protocol/NetBufferStatistics.h>
 
 #include <Guid/SmBios.h>
 
@@ -1855,6 +1856,7 @@ NetLibDefaultUnload (
   EFI_DRIVER_BINDING_PROTOCOL   *DriverBinding;
   EFI_COMPONENT_NAME_PROTOCOL   *ComponentName;
   EFI_COMPONENT_NAME2_PROTOCOL  *ComponentName2;
+  VOID                          *NetbufStatistics;
 
   //
   // Get the list of all the handles in the handle database.
@@ -1942,6 +1944,22 @@ NetLibDefaultUnload (
     gBS->FreePool (DeviceHandleBuffer);
   }
 
+  //
+  // Uninstall the net buffer statistics installed by NetbufInstallStatistics()
+  //
+  Status = gBS->HandleProtocol (
+                  ImageHandle,
+                  &gEdkiiNetBufferStatisticsProtocolGuid,
+                  &NetbufStatistics
+                  );
+  if (!EFI_ERROR (Status)) {
+    gBS->UninstallProtocolInterface (
+           ImageHandle,
+           &gEdkiiNetBufferStatisticsProtocolGuid,
+           NetbufStatistics
+           );
+  }
+
   return EFI_SUCCESS;
 }
 
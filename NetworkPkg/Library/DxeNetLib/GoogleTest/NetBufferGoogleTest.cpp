@@ -0,0 +1,116 @@
+/** @file
+  Tests for NetBuffer.c.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/NetLib.h>
+}
+
+////////////////////////////////////////////////////////////////////////
+// NetblockChecksum Tests
+////////////////////////////////////////////////////////////////////////
+
+class NetblockChecksumTest : public ::testing::Test {
+protected:
+  UINT8 Buffer[2048 + 16];
+
+  virtual void
+  SetUp (
+    )
+  {
+    UINTN   Index;
+    UINT32  Seed;
+
+    //
+    // Fill the buffer with pseudo-random data.
+    //
+    Seed = 0x12345678;
+    for (Index = 0; Index < sizeof (Buffer); Index++) {
+      Seed          = Seed * 1103515245 + 12345;
+      Buffer[Index] = (UINT8)(Seed >> 16);
+    }
+  }
+
+  //
+  // The reference checksum: 16 bits at a time, with the bytes in memory
+  // order, as the previous implementation did.
+  //
+  UINT16
+  ReferenceChecksum (
+    UINT8   *Bulk,
+    UINT32  Len
+    )
+  {
+    UINT32  Sum;
+    UINT32  Index;
+
+    Sum = 0;
+    for (Index = 0; Index + 1 < Len; Index += 2) {
+      Sum += (UINT32)Bulk[Index] | ((UINT32)Bulk[Index + 1] << 8);
+    }
+
+    if ((Len % 2) != 0) {
+      Sum += Bulk[Len - 1];
+    }
+
+    while ((Sum >> 16) != 0) {
+      Sum = (Sum & 0xffff) + (Sum >> 16);
+    }
+
+    return (UINT16)Sum;
+  }
+};
+
+// Test every alignment with lengths around the sizes of the unrolled loops.
+TEST_F (NetblockChecksumTest, MatchesReferenceForAllAlignments) {
+  UINT32  Offset;
+  UINT32  Len;
+
+  for (Offset = 0; Offset < 16; Offset++) {
+    for (Len = 0; Len <= 80; Len++) {
+      ASSERT_EQ (NetblockChecksum (Buffer + Offset, Len), ReferenceChecksum (Buffer + Offset, Len))
+        << "Offset " << Offset << " Len " << Len;
+    }
+
+    for (Len = 1400; Len <= 1520; Len++) {
+      ASSERT_EQ (NetblockChecksum (Buffer + Offset, Len), ReferenceChecksum (Buffer + Offset, Len))
+        << "Offset " << Offset << " Len " << Len;
+    }
+  }
+}
+
+// Test that large sums with many carries fold correctly.
+TEST_F (NetblockChecksumTest, AllOnes) {
+  UINT32  Offset;
+
+  SetMem (Buffer, sizeof (Buffer), 0xff);
+  for (Offset = 0; Offset < 16; Offset++) {
+    EXPECT_EQ (NetblockChecksum (Buffer + Offset, 2048), 0xffff);
+    EXPECT_EQ (NetblockChecksum (Buffer + Offset, 2047), ReferenceChecksum (Buffer + Offset, 2047));
+  }
+}
+
+// Test that only zero data sums to zero.
+TEST_F (NetblockChecksumTest, Zeros) {
+  ZeroMem (Buffer, sizeof (Buffer));
+  EXPECT_EQ (NetblockChecksum (Buffer, 0), 0);
+  EXPECT_EQ (NetblockChecksum (Buffer + 1, 1500), 0);
+}
+
+// Test a known IPv4 header, whose checksum field is filled in.
+TEST_F (NetblockChecksumTest, Ip4Header) {
+  UINT8  Header[] = {
+    0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+    0x40, 0x11, 0xb8, 0x61, 0xc0, 0xa8, 0x00, 0x01,
+    0xc0, 0xa8, 0x00, 0xc7
+  };
+
+  EXPECT_EQ ((UINT16) ~NetblockChecksum (Header, sizeof (Header)), 0);
+}
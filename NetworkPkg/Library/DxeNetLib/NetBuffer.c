@@ -14,6 +14,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 
+#include <Protocol/NetBufferStatistics.h>
+
+//
+// The number of bytes copied by the net buffer functions in this module.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED UINT64  mNetbufCopiedBytes = 0;
+
 /**
   Allocate and build up the sketch for a NET_BUF.
 
@@ -800,6 +807,8 @@ NetbufFromExt (
     }
   }
 
+  mNetbufCopiedBytes += Copied;
+
   Nbuf = NetbufAllocStruct (BlockNum, BlockNum);
 
   if (Nbuf == NULL) {
@@ -1228,6 +1237,8 @@ NetbufCopy (
     Len = Nbuf->TotalSize - Offset;
   }
 
+  mNetbufCopiedBytes += Len;
+
   BlockOp = Nbuf->BlockOp;
 
   //
@@ -1289,6 +1300,102 @@ NetbufCopy (
   return Copied;
 }
 
+/**
+  Get the number of bytes the net buffer functions have copied in this module.
+
+  Each network driver has its own instance of the library, so the count is the
+  copy cost of the layer the driver implements. It includes the data copied by
+  NetbufCopy(), NetbufDuplicate(), NetbufQueCopy() and the headers aggregated
+  by NetbufFromExt().
+
+  @return           The number of bytes copied.
+
+**/
+UINT64
+EFIAPI
+NetbufGetCopiedBytes (
+  VOID
+  )
+{
+  return mNetbufCopiedBytes;
+}
+
+/**
+  Get the statistics of the net buffers of this module.
+
+  @param[in]  This        The EDKII_NET_BUFFER_STATISTICS_PROTOCOL instance.
+  @param[out] Statistics  The statistics of the net buffers.
+
+  @retval EFI_SUCCESS            The statistics are returned.
+  @retval EFI_INVALID_PARAMETER  Statistics is NULL.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+NetbufGetStatistics (
+  IN  EDKII_NET_BUFFER_STATISTICS_PROTOCOL  *This,
+  OUT EDKII_NET_BUFFER_STATISTICS           *Statistics
+  )
+{
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Statistics->CopiedBytes = mNetbufCopiedBytes;
+  return EFI_SUCCESS;
+}
+
+/**
+  Clear the statistics of the net buffers of this module.
+
+  @param[in] This  The EDKII_NET_BUFFER_STATISTICS_PROTOCOL instance.
+
+  @retval EFI_SUCCESS  The statistics are cleared.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+NetbufResetStatistics (
+  IN EDKII_NET_BUFFER_STATISTICS_PROTOCOL  *This
+  )
+{
+  mNetbufCopiedBytes = 0;
+  return EFI_SUCCESS;
+}
+
+GLOBAL_REMOVE_IF_UNREFERENCED EDKII_NET_BUFFER_STATISTICS_PROTOCOL  mNetbufStatistics = {
+  NetbufGetStatistics,
+  NetbufResetStatistics
+};
+
+/**
+  Install the EDKII_NET_BUFFER_STATISTICS_PROTOCOL on the image handle of the
+  network driver, to report the count of NetbufGetCopiedBytes() of this module.
+
+  NetLibDefaultUnload() uninstalls the protocol when the driver is unloaded.
+
+  @param[in]  ImageHandle       The image handle of the network driver.
+
+  @retval EFI_SUCCESS           The protocol is installed.
+  @retval Others                Failed to install the protocol.
+
+**/
+EFI_STATUS
+EFIAPI
+NetbufInstallStatistics (
+  IN EFI_HANDLE  ImageHandle
+  )
+{
+  return gBS->InstallProtocolInterface (
+                &ImageHandle,
+                &gEdkiiNetBufferStatisticsProtocolGuid,
+                EFI_NATIVE_INTERFACE,
+                &mNetbufStatistics
+                );
+}
+
 /**
   Initiate the net buffer queue.
 
@@ -1608,6 +1715,12 @@ NetbufQueFlush (
 /**
   Compute the checksum for a bulk of data.
 
+  The data is summed 64 bits at a time from an aligned address. As 2^16 is 1
+  modulo 0xffff, the 32-bit halves can be accumulated in a 64-bit sum and
+  folded once at the end (RFC 1071). If the data starts at an odd address,
+  every 16-bit word is read with its bytes swapped, so the folded sum is
+  swapped back.
+
   @param[in]   Bulk                  Pointer to the data.
   @param[in]   Len                   Length of the data, in bytes.
 
@@ -1621,17 +1734,42 @@ NetblockChecksum (
   IN UINT32  Len
   )
 {
-  register UINT32  Sum;
+  UINT64   Sum;
+  UINT64   *Data;
+  BOOLEAN  Odd;
 
   Sum = 0;
+  Odd = (BOOLEAN)(((UINTN)Bulk & 1) != 0);
 
-  //
-  // Add left-over byte, if any
-  //
-  if (Len % 2 != 0) {
-    Sum += *(Bulk + Len - 1);
+  if (Odd && (Len > 0)) {
+    Sum  = (UINT64)*Bulk << 8;
+    Bulk = Bulk + 1;
+    Len  = Len - 1;
+  }
+
+  while ((Len > 1) && (((UINTN)Bulk & 7) != 0)) {
+    Sum  += *(UINT16 *)Bulk;
+    Bulk += 2;
+    Len  -= 2;
+  }
+
+  Data = (UINT64 *)Bulk;
+  while (Len >= 32) {
+    Sum += (UINT32)Data[0] + (Data[0] >> 32);
+    Sum += (UINT32)Data[1] + (Data[1] >> 32);
+    Sum += (UINT32)Data[2] + (Data[2] >> 32);
+    Sum += (UINT32)Data[3] + (Data[3] >> 32);
+    Data += 4;
+    Len  -= 32;
   }
 
+  while (Len >= 8) {
+    Sum += (UINT32)Data[0] + (Data[0] >> 32);
+    Data++;
+    Len -= 8;
+  }
+
+  Bulk = (UINT8 *)Data;
   while (Len > 1) {
     Sum  += *(UINT16 *)Bulk;
     Bulk += 2;
@@ -1639,12 +1777,25 @@ NetblockChecksum (
   }
 
   //
-  // Fold 32-bit sum to 16 bits
+  // Add left-over byte, if any
   //
+  if (Len != 0) {
+    Sum += *Bulk;
+  }
+
+  //
+  // Fold 64-bit sum to 16 bits
+  //
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
   while ((Sum >> 16) != 0) {
     Sum = (Sum & 0xffff) + (Sum >> 16);
   }
 
+  if (Odd) {
+    Sum = ((Sum & 0xff) << 8) | (Sum >> 8);
+  }
+
   return (UINT16)Sum;
 }
 
@@ -668,12 +668,19 @@ MnpDriverEntryPoint (
   IN EFI_SYSTEM_TABLE  *SystemTable
   )
 {
-  return EfiLibInstallDriverBindingComponentName2 (
-           ImageHandle,
-           SystemTable,
-           &gMnpDriverBinding,
-           ImageHandle,
-           &gMnpComponentName,
-           &gMnpComponentName2
-           );
+  EFI_STATUS  Status;
+
+  Status = EfiLibInstallDriverBindingComponentName2 (
+             ImageHandle,
+             SystemTable,
+             &gMnpDriverBinding,
+             ImageHandle,
+             &gMnpComponentName,
+             &gMnpComponentName2
+             );
+  if (!EFI_ERROR (Status)) {
+    NetbufInstallStatistics (ImageHandle);
+  }
+
+  return Status;
 }
@@ -985,6 +985,45 @@ EXIT:
   return Status;
 }
 
+/**
+  Receive and deliver the packets queued in Snp, up to MNP_RECEIVE_BURST_NUM
+  of them.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval EFI_NOT_STARTED       The simple network protocol is not started.
+  @retval EFI_NOT_READY         No packet received.
+  @retval EFI_DEVICE_ERROR      An unexpected error occurs.
+
+**/
+EFI_STATUS
+MnpReceivePackets (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Count;
+
+  Status = EFI_NOT_READY;
+  for (Count = 0; Count < MNP_RECEIVE_BURST_NUM; Count++) {
+    Status = MnpReceivePacket (MnpDeviceData);
+
+    //
+    // Dispatch the DPC queued by the NotifyFunction of rx token's events,
+    // so that the receivers recycle the packet and post a new rx token
+    // before the next packet is received.
+    //
+    DispatchDpc ();
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  return (Count == 0) ? Status : EFI_SUCCESS;
+}
+
 /**
   Remove the received packets if timeout occurs.
 
@@ -1104,12 +1143,8 @@ MnpSystemPoll (
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
   //
-  // Try to receive packets from Snp.
+  // Try to receive packets from Snp, draining its receive queue
+  // in a burst rather than taking one packet per timer tick.
   //
-  MnpReceivePacket (MnpDeviceData);
-
-  //
-  // Dispatch the DPC queued by the NotifyFunction of rx token's events.
-  //
-  DispatchDpc ();
+  MnpReceivePackets (MnpDeviceData);
 }
@@ -480,6 +480,7 @@ Mtftp4InitProtocol (
   Instance->Service = MtftpSb;
 
   InitializeListHead (&Instance->Blocks);
+  Instance->WindowSizeLimit = MAX_UINT16;
 }
 
 /**
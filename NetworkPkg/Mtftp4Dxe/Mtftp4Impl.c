@@ -67,12 +67,28 @@ Mtftp4CleanOperation (
     FreePool (Block);
   }
 
+  //
+  // Adapt the window size requested by the next downloads: halve it after a
+  // download with losses, double it after a download without any.
+  //
+  if (((Instance->Operation == EFI_MTFTP4_OPCODE_RRQ) || (Instance->Operation == EFI_MTFTP4_OPCODE_DIR)) &&
+      (Instance->WindowSize > 1))
+  {
+    if (Instance->LossCount != 0) {
+      Instance->WindowSizeLimit = (UINT16)MAX (Instance->WindowSize / 2, 2);
+    } else if (!EFI_ERROR (Result)) {
+      Instance->WindowSizeLimit = (UINT16)MIN ((UINT32)Instance->WindowSize * 2, MAX_UINT16);
+    }
+  }
+
   ZeroMem (&Instance->RequestOption, sizeof (MTFTP4_OPTION));
 
   Instance->Operation = 0;
 
   Instance->BlkSize       = MTFTP4_DEFAULT_BLKSIZE;
   Instance->WindowSize    = 1;
+  Instance->LossCount     = 0;
+  Instance->HoleAcked     = FALSE;
   Instance->TotalBlock    = 0;
   Instance->AckedBlock    = 0;
   Instance->LastBlock     = 0;
@@ -431,6 +447,10 @@ Mtftp4Start (
       TokenStatus = EFI_DEVICE_ERROR;
       goto ON_ERROR;
     }
+
+    if (Instance->RequestOption.WindowSize > Instance->WindowSizeLimit) {
+      Instance->RequestOption.WindowSize = Instance->WindowSizeLimit;
+    }
   }
 
   //
@@ -116,6 +116,19 @@ struct _MTFTP4_PROTOCOL {
 
   UINT16                    WindowSize;
 
+  //
+  // The largest window size requested from the server. It is adapted to the
+  // losses seen in the downloads, and kept across operations.
+  //
+  UINT16                    WindowSizeLimit;
+
+  //
+  // Number of lost packets in the current download, and whether the ACK for
+  // the current hole in the received blocks has already been sent.
+  //
+  UINT32                    LossCount;
+  BOOLEAN                   HoleAcked;
+
   //
   // Record the total received and saved block number.
   //
@@ -264,6 +264,18 @@ Mtftp4RrqHandleData (
   // expected one. If we are passive (Slave), save the block.
   //
   if (Instance->Master && (Expected != BlockNum)) {
+    //
+    // With a window, the rest of the window keeps arriving after a lost
+    // block. ACK the hole only once so that the server restarts the window
+    // once, the ACK is retransmitted on timeout if it is lost.
+    //
+    if (Instance->HoleAcked && (Instance->WindowSize > 1)) {
+      return EFI_SUCCESS;
+    }
+
+    Instance->HoleAcked = TRUE;
+    Instance->LossCount++;
+
     //
     // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
     //
@@ -276,6 +288,8 @@ Mtftp4RrqHandleData (
     return Status;
   }
 
+  Instance->HoleAcked = FALSE;
+
   //
   // Record the total received and saved block number.
   //
@@ -273,6 +273,8 @@ Mtftp4SendRequest (
   UINTN              ModeLength;
   UINTN              OptionStrLength;
   UINTN              ValueStrLength;
+  UINT8              *ValueStr;
+  CHAR8              WindowSizeStr[6];
 
   Token   = Instance->Token;
   Options = Token->OptionList;
@@ -289,9 +291,19 @@ Mtftp4SendRequest (
   ModeLength     = AsciiStrLen ((CHAR8 *)Mode);
   BufferLength   = (UINT32)FileNameLength + (UINT32)ModeLength + 4;
 
+  //
+  // The window size requested may have been reduced after losses.
+  //
+  AsciiSPrint (WindowSizeStr, sizeof (WindowSizeStr), "%d", Instance->RequestOption.WindowSize);
+
   for (Index = 0; Index < Token->OptionCount; Index++) {
+    ValueStr = Options[Index].ValueStr;
+    if (AsciiStriCmp ((CHAR8 *)Options[Index].OptionStr, "windowsize") == 0) {
+      ValueStr = (UINT8 *)WindowSizeStr;
+    }
+
     OptionStrLength = AsciiStrLen ((CHAR8 *)Options[Index].OptionStr);
-    ValueStrLength  = AsciiStrLen ((CHAR8 *)Options[Index].ValueStr);
+    ValueStrLength  = AsciiStrLen ((CHAR8 *)ValueStr);
     BufferLength   += (UINT32)OptionStrLength + (UINT32)ValueStrLength + 2;
   }
 
@@ -319,15 +331,20 @@ Mtftp4SendRequest (
   Cur          += ModeLength + 1;
 
   for (Index = 0; Index < Token->OptionCount; ++Index) {
+    ValueStr = Options[Index].ValueStr;
+    if (AsciiStriCmp ((CHAR8 *)Options[Index].OptionStr, "windowsize") == 0) {
+      ValueStr = (UINT8 *)WindowSizeStr;
+    }
+
     OptionStrLength = AsciiStrLen ((CHAR8 *)Options[Index].OptionStr);
-    ValueStrLength  = AsciiStrLen ((CHAR8 *)Options[Index].ValueStr);
+    ValueStrLength  = AsciiStrLen ((CHAR8 *)ValueStr);
 
     Status = AsciiStrCpyS ((CHAR8 *)Cur, BufferLength, (CHAR8 *)Options[Index].OptionStr);
     ASSERT_EFI_ERROR (Status);
     BufferLength -= (UINT32)(OptionStrLength + 1);
     Cur          += OptionStrLength + 1;
 
-    Status = AsciiStrCpyS ((CHAR8 *)Cur, BufferLength, (CHAR8 *)Options[Index].ValueStr);
+    Status = AsciiStrCpyS ((CHAR8 *)Cur, BufferLength, (CHAR8 *)ValueStr);
     ASSERT_EFI_ERROR (Status);
     BufferLength -= (UINT32)(ValueStrLength + 1);
     Cur          += ValueStrLength + 1;
@@ -640,6 +657,7 @@ Mtftp4OnTimerTick (
     // otherwise exit the transfer.
     //
     if (++Instance->CurRetry < Instance->MaxRetry) {
+      Instance->LossCount++;
       Mtftp4Retransmit (Instance);
       Mtftp4SetTimeout (Instance);
     } else {
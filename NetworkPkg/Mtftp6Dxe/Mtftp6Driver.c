@@ -218,6 +218,7 @@ Mtftp6CreateInstance (
 
   InitializeListHead (&Mtftp6Ins->Link);
   InitializeListHead (&Mtftp6Ins->BlkList);
+  Mtftp6Ins->WindowSizeLimit = MAX_UINT16;
 
   *Instance = Mtftp6Ins;
 
@@ -76,6 +76,19 @@ struct _MTFTP6_INSTANCE {
 
   UINT16                    WindowSize;
 
+  //
+  // The largest window size requested from the server. It is adapted to the
+  // losses seen in the downloads, and kept across operations.
+  //
+  UINT16                    WindowSizeLimit;
+
+  //
+  // Number of lost packets in the current download, and whether the ACK for
+  // the current hole in the received blocks has already been sent.
+  //
+  UINT32                    LossCount;
+  BOOLEAN                   HoleAcked;
+
   //
   // Record the total received and saved block number.
   //
@@ -241,6 +241,18 @@ Mtftp6RrqHandleData (
     NetbufFree (*UdpPacket);
     *UdpPacket = NULL;
 
+    //
+    // With a window, the rest of the window keeps arriving after a lost
+    // block. ACK the hole only once so that the server restarts the window
+    // once, the ACK is retransmitted on timeout if it is lost.
+    //
+    if (Instance->HoleAcked && (Instance->WindowSize > 1)) {
+      return EFI_SUCCESS;
+    }
+
+    Instance->HoleAcked = TRUE;
+    Instance->LossCount++;
+
     //
     // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
     //
@@ -253,6 +265,8 @@ Mtftp6RrqHandleData (
     return Status;
   }
 
+  Instance->HoleAcked = FALSE;
+
   //
   // Record the total received and saved block number.
   //
@@ -337,7 +351,7 @@ Mtftp6RrqOackValid (
   // return the timeout matches that requested.
   //
   if ((((ReplyInfo->BitMap & MTFTP6_OPT_BLKSIZE_BIT) != 0) && (ReplyInfo->BlkSize > RequestInfo->BlkSize)) ||
-      (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->BlkSize > RequestInfo->BlkSize)) ||
+      (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->WindowSize > RequestInfo->WindowSize)) ||
       (((ReplyInfo->BitMap & MTFTP6_OPT_TIMEOUT_BIT) != 0) && (ReplyInfo->Timeout != RequestInfo->Timeout))
       )
   {
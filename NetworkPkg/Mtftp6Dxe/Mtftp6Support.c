@@ -466,6 +466,8 @@ Mtftp6SendRequest (
   UINTN              ModeLength;
   UINTN              OptionStrLength;
   UINTN              ValueStrLength;
+  UINT8              *ValueStr;
+  CHAR8              WindowSizeStr[6];
 
   Token   = Instance->Token;
   Options = Token->OptionList;
@@ -498,9 +500,19 @@ Mtftp6SendRequest (
   ModeLength     = AsciiStrLen ((CHAR8 *)Mode);
   BufferLength   = (UINT32)FileNameLength + (UINT32)ModeLength + 4;
 
+  //
+  // The window size requested may have been reduced after losses.
+  //
+  AsciiSPrint (WindowSizeStr, sizeof (WindowSizeStr), "%d", Instance->ExtInfo.WindowSize);
+
   for (Index = 0; Index < Token->OptionCount; Index++) {
+    ValueStr = Options[Index].ValueStr;
+    if (AsciiStriCmp ((CHAR8 *)Options[Index].OptionStr, "windowsize") == 0) {
+      ValueStr = (UINT8 *)WindowSizeStr;
+    }
+
     OptionStrLength = AsciiStrLen ((CHAR8 *)Options[Index].OptionStr);
-    ValueStrLength  = AsciiStrLen ((CHAR8 *)Options[Index].ValueStr);
+    ValueStrLength  = AsciiStrLen ((CHAR8 *)ValueStr);
     BufferLength   += (UINT32)OptionStrLength + (UINT32)ValueStrLength + 2;
   }
 
@@ -534,15 +546,20 @@ Mtftp6SendRequest (
   // Copy all the extension options into the packet.
   //
   for (Index = 0; Index < Token->OptionCount; ++Index) {
+    ValueStr = Options[Index].ValueStr;
+    if (AsciiStriCmp ((CHAR8 *)Options[Index].OptionStr, "windowsize") == 0) {
+      ValueStr = (UINT8 *)WindowSizeStr;
+    }
+
     OptionStrLength = AsciiStrLen ((CHAR8 *)Options[Index].OptionStr);
-    ValueStrLength  = AsciiStrLen ((CHAR8 *)Options[Index].ValueStr);
+    ValueStrLength  = AsciiStrLen ((CHAR8 *)ValueStr);
 
     Status = AsciiStrCpyS ((CHAR8 *)Cur, BufferLength, (CHAR8 *)Options[Index].OptionStr);
     ASSERT_EFI_ERROR (Status);
     BufferLength -= (UINT32)(OptionStrLength + 1);
     Cur          += OptionStrLength + 1;
 
-    Status = AsciiStrCpyS ((CHAR8 *)Cur, BufferLength, (CHAR8 *)Options[Index].ValueStr);
+    Status = AsciiStrCpyS ((CHAR8 *)Cur, BufferLength, (CHAR8 *)ValueStr);
     ASSERT_EFI_ERROR (Status);
     BufferLength -= (UINT32)(ValueStrLength + 1);
     Cur          += ValueStrLength + 1;
@@ -943,6 +960,20 @@ Mtftp6OperationClean (
     FreePool (Block);
   }
 
+  //
+  // Adapt the window size requested by the next downloads: halve it after a
+  // download with losses, double it after a download without any.
+  //
+  if (((Instance->Operation == EFI_MTFTP6_OPCODE_RRQ) || (Instance->Operation == EFI_MTFTP6_OPCODE_DIR)) &&
+      (Instance->WindowSize > 1))
+  {
+    if (Instance->LossCount != 0) {
+      Instance->WindowSizeLimit = (UINT16)MAX (Instance->WindowSize / 2, 2);
+    } else if (!EFI_ERROR (Result)) {
+      Instance->WindowSizeLimit = (UINT16)MIN ((UINT32)Instance->WindowSize * 2, MAX_UINT16);
+    }
+  }
+
   //
   // Reinitialize the corresponding fields of the Mtftp6 operation.
   //
@@ -956,6 +987,8 @@ Mtftp6OperationClean (
   Instance->BlkSize        = 0;
   Instance->Operation      = 0;
   Instance->WindowSize     = 1;
+  Instance->LossCount      = 0;
+  Instance->HoleAcked      = FALSE;
   Instance->TotalBlock     = 0;
   Instance->AckedBlock     = 0;
   Instance->LastBlk        = 0;
@@ -1048,6 +1081,10 @@ Mtftp6OperationStart (
     if (EFI_ERROR (Status)) {
       goto ON_ERROR;
     }
+
+    if (Instance->ExtInfo.WindowSize > Instance->WindowSizeLimit) {
+      Instance->ExtInfo.WindowSize = Instance->WindowSizeLimit;
+    }
   }
 
   //
@@ -1215,6 +1252,7 @@ Mtftp6OnTimerTick (
     // otherwise exit the transfer.
     //
     if (Instance->CurRetry < Instance->MaxRetry) {
+      Instance->LossCount++;
       Mtftp6TransmitPacket (Instance, Instance->LastPacket);
     } else {
       Mtftp6OperationClean (Instance, EFI_TIMEOUT);
@@ -0,0 +1,336 @@
+/** @file
+  Tests for TcpOption.c.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include "../TcpMain.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+UINT32  mTcpTick = 1000;
+
+////////////////////////////////////////////////////////////////////////
+// TcpParseOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpParseOptionTest : public ::testing::Test {
+protected:
+  //
+  // A TCP header followed by the options, with room for a parser that
+  // reads one byte past the options.
+  //
+  UINT8 Buffer[sizeof (TCP_HEAD) + TCP_OPTION_MAX_LEN + 4];
+  TCP_OPTION Option;
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (Buffer, sizeof (Buffer));
+    ZeroMem (&Option, sizeof (Option));
+  }
+
+  INTN
+  Parse (
+    CONST UINT8  *Options,
+    UINT8        Length
+    )
+  {
+    TCP_HEAD  *Tcp;
+
+    Tcp          = (TCP_HEAD *)Buffer;
+    Tcp->HeadLen = (UINT8)((sizeof (TCP_HEAD) + Length) >> 2);
+    CopyMem (Buffer + sizeof (TCP_HEAD), Options, Length);
+    return TcpParseOption (Tcp, &Option);
+  }
+};
+
+// Test the SACK permitted option on its own.
+TEST_F (TcpParseOptionTest, SackPermittedIsParsed) {
+  UINT8  Options[] = { TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK_PERM, TCP_OPTION_SACK_PERM_LEN };
+
+  ASSERT_EQ (Parse (Options, sizeof (Options)), 0);
+  EXPECT_EQ (Option.Flag, TCP_OPTION_RCVD_SACK_PERM);
+}
+
+// Test the SACK permitted option between the other options of a SYN.
+TEST_F (TcpParseOptionTest, SackPermittedWithOtherOptionsIsParsed) {
+  UINT8  Options[] = {
+    TCP_OPTION_MSS,       TCP_OPTION_MSS_LEN,       0x05,           0xb4,
+    TCP_OPTION_SACK_PERM, TCP_OPTION_SACK_PERM_LEN, TCP_OPTION_NOP, TCP_OPTION_WS,
+    TCP_OPTION_WS_LEN,    7,                        TCP_OPTION_EOP, TCP_OPTION_EOP
+  };
+
+  ASSERT_EQ (Parse (Options, sizeof (Options)), 0);
+  EXPECT_EQ (Option.Flag, TCP_OPTION_RCVD_MSS | TCP_OPTION_RCVD_WS | TCP_OPTION_RCVD_SACK_PERM);
+  EXPECT_EQ (Option.Mss, 1460);
+  EXPECT_EQ (Option.WndScale, 7);
+}
+
+// Test that a segment without the SACK permitted option does not enable SACK.
+TEST_F (TcpParseOptionTest, NoSackPermitted) {
+  UINT8  Options[] = { TCP_OPTION_MSS, TCP_OPTION_MSS_LEN, 0x05, 0xb4 };
+
+  ASSERT_EQ (Parse (Options, sizeof (Options)), 0);
+  EXPECT_EQ (Option.Flag, TCP_OPTION_RCVD_MSS);
+}
+
+// Test SACK permitted options whose length is not 2.
+TEST_F (TcpParseOptionTest, SackPermittedWithWrongLengthIsRejected) {
+  UINT8  Options[][4] = {
+    { TCP_OPTION_SACK_PERM, 0, TCP_OPTION_NOP, TCP_OPTION_NOP },
+    { TCP_OPTION_SACK_PERM, 1, TCP_OPTION_NOP, TCP_OPTION_NOP },
+    { TCP_OPTION_SACK_PERM, 3, TCP_OPTION_NOP, TCP_OPTION_NOP },
+    { TCP_OPTION_SACK_PERM, 4, TCP_OPTION_NOP, TCP_OPTION_NOP },
+  };
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (Options); Index++) {
+    EXPECT_EQ (Parse (Options[Index], sizeof (Options[Index])), -1) << "Length " << (UINTN)Options[Index][1];
+  }
+}
+
+// Test a SACK permitted option cut off by the end of the options.
+TEST_F (TcpParseOptionTest, TruncatedSackPermittedIsRejected) {
+  UINT8  Options[] = { TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK_PERM };
+
+  //
+  // The byte following the options must not be taken as the length.
+  //
+  Buffer[sizeof (TCP_HEAD) + sizeof (Options)] = TCP_OPTION_SACK_PERM_LEN;
+  EXPECT_EQ (Parse (Options, sizeof (Options)), -1);
+}
+
+// Test that a SACK option sent by the peer is skipped.
+TEST_F (TcpParseOptionTest, SackIsSkipped) {
+  UINT8  Options[] = {
+    TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK, 2 + TCP_OPTION_SACK_BLOCK_LEN,
+    0x00,           0x00,           0x10,            0x00,
+    0x00,           0x00,           0x20,            0x00
+  };
+
+  ASSERT_EQ (Parse (Options, sizeof (Options)), 0);
+  EXPECT_EQ (Option.Flag, 0);
+}
+
+// Test SACK options whose length is too short or longer than the options.
+TEST_F (TcpParseOptionTest, SackWithWrongLengthIsRejected) {
+  UINT8  Options[][8] = {
+    { TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK, 0,                                0, 0, 0, 0 },
+    { TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK, 1,                                0, 0, 0, 0 },
+    { TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK, 2 + TCP_OPTION_SACK_BLOCK_LEN,    0, 0, 0, 0 },
+    { TCP_OPTION_NOP, TCP_OPTION_NOP, TCP_OPTION_SACK, 2 + 4 * TCP_OPTION_SACK_BLOCK_LEN, 0, 0, 0, 0 },
+  };
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (Options); Index++) {
+    EXPECT_EQ (Parse (Options[Index], sizeof (Options[Index])), -1) << "Length " << (UINTN)Options[Index][3];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+// TcpBuildOption Tests
+////////////////////////////////////////////////////////////////////////
+
+class TcpBuildOptionTest : public ::testing::Test {
+protected:
+  TCP_CB Tcb;
+  NET_BUF *Nbuf;
+  UINT8 Options[TCP_OPTION_MAX_LEN];
+
+  virtual void
+  SetUp (
+    )
+  {
+    ZeroMem (&Tcb, sizeof (Tcb));
+    InitializeListHead (&Tcb.RcvQue);
+    TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_SND_SACK);
+
+    Nbuf = NetbufAlloc (TCP_MAX_HEAD + 16);
+    ASSERT_NE (Nbuf, nullptr);
+    NetbufReserve (Nbuf, TCP_MAX_HEAD);
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    NET_BUF  *Seg;
+
+    while (!IsListEmpty (&Tcb.RcvQue)) {
+      Seg = NET_LIST_HEAD (&Tcb.RcvQue, NET_BUF, List);
+      RemoveEntryList (&Seg->List);
+      NetbufFree (Seg);
+    }
+
+    NetbufFree (Nbuf);
+  }
+
+  //
+  // Add a segment to the reassemble queue, which is kept in sequence order.
+  //
+  void
+  QueueSegment (
+    TCP_SEQNO  Seq,
+    UINT32     Len
+    )
+  {
+    NET_BUF  *Seg;
+
+    Seg = NetbufAlloc (16);
+    ASSERT_NE (Seg, nullptr);
+    TCPSEG_NETBUF (Seg)->Seq = Seq;
+    TCPSEG_NETBUF (Seg)->End = Seq + Len;
+    InsertTailList (&Tcb.RcvQue, &Seg->List);
+  }
+
+  UINT16
+  Build (
+    )
+  {
+    UINT16  Len;
+
+    Len = TcpBuildOption (&Tcb, Nbuf);
+    EXPECT_EQ (Nbuf->TotalSize, Len);
+    EXPECT_LE (Len, TCP_OPTION_MAX_LEN);
+    NetbufCopy (Nbuf, 0, MIN (Len, TCP_OPTION_MAX_LEN), Options);
+    return Len;
+  }
+
+  UINT32
+  GetUint32 (
+    UINTN  Offset
+    )
+  {
+    return ((UINT32)Options[Offset] << 24) | ((UINT32)Options[Offset + 1] << 16) |
+           ((UINT32)Options[Offset + 2] << 8) | Options[Offset + 3];
+  }
+
+  //
+  // Check the SACK option at Offset, which must hold the given blocks.
+  //
+  void
+  ExpectSack (
+    UINTN            Offset,
+    CONST TCP_SEQNO  Blocks[][2],
+    UINTN            Count
+    )
+  {
+    UINTN  Index;
+
+    EXPECT_EQ (Options[Offset], TCP_OPTION_NOP);
+    EXPECT_EQ (Options[Offset + 1], TCP_OPTION_NOP);
+    EXPECT_EQ (Options[Offset + 2], TCP_OPTION_SACK);
+    EXPECT_EQ (Options[Offset + 3], 2 + Count * TCP_OPTION_SACK_BLOCK_LEN);
+    for (Index = 0; Index < Count; Index++) {
+      EXPECT_EQ (GetUint32 (Offset + 4 + Index * TCP_OPTION_SACK_BLOCK_LEN), Blocks[Index][0]) << "Block " << Index;
+      EXPECT_EQ (GetUint32 (Offset + 8 + Index * TCP_OPTION_SACK_BLOCK_LEN), Blocks[Index][1]) << "Block " << Index;
+    }
+  }
+};
+
+// Test that no SACK option is sent without out-of-order data.
+TEST_F (TcpBuildOptionTest, NoSackWithoutOutOfOrderData) {
+  EXPECT_EQ (Build (), 0);
+}
+
+// Test that no SACK option is sent when SACK was not negotiated.
+TEST_F (TcpBuildOptionTest, NoSackWhenNotNegotiated) {
+  TCP_CLEAR_FLG (Tcb.CtrlFlag, TCP_CTRL_SND_SACK);
+  QueueSegment (2000, 100);
+  EXPECT_EQ (Build (), 0);
+}
+
+// Test that no SACK option is added to segments that carry data.
+TEST_F (TcpBuildOptionTest, NoSackOnDataSegments) {
+  ASSERT_NE (NetbufAllocSpace (Nbuf, 10, NET_BUF_TAIL), nullptr);
+  QueueSegment (2000, 100);
+  EXPECT_EQ (TcpBuildOption (&Tcb, Nbuf), 0);
+}
+
+// Test that contiguous segments are reported as one block.
+TEST_F (TcpBuildOptionTest, ContiguousSegmentsAreOneBlock) {
+  CONST TCP_SEQNO  Blocks[][2] = {
+    { 2000, 2300 }
+  };
+
+  QueueSegment (2000, 100);
+  QueueSegment (2100, 100);
+  QueueSegment (2200, 100);
+  Tcb.SackSeq = 2100;
+
+  ASSERT_EQ (Build (), TCP_OPTION_SACK_ALIGNED_LEN + TCP_OPTION_SACK_BLOCK_LEN);
+  ExpectSack (0, Blocks, ARRAY_SIZE (Blocks));
+}
+
+// Test that the block with the latest segment is reported first.
+TEST_F (TcpBuildOptionTest, LatestBlockIsFirst) {
+  CONST TCP_SEQNO  Blocks[][2] = {
+    { 3000, 3100 },
+    { 2000, 2100 },
+    { 4000, 4200 }
+  };
+
+  QueueSegment (2000, 100);
+  QueueSegment (3000, 100);
+  QueueSegment (4000, 100);
+  QueueSegment (4100, 100);
+  Tcb.SackSeq = 3000;
+
+  ASSERT_EQ (Build (), TCP_OPTION_SACK_ALIGNED_LEN + 3 * TCP_OPTION_SACK_BLOCK_LEN);
+  ExpectSack (0, Blocks, ARRAY_SIZE (Blocks));
+}
+
+// Test that at most 4 blocks are reported.
+TEST_F (TcpBuildOptionTest, AtMostFourBlocks) {
+  CONST TCP_SEQNO  Blocks[][2] = {
+    { 7000, 7100 },
+    { 2000, 2100 },
+    { 3000, 3100 },
+    { 4000, 4100 }
+  };
+  TCP_SEQNO        Seq;
+
+  for (Seq = 2000; Seq <= 7000; Seq += 1000) {
+    QueueSegment (Seq, 100);
+  }
+
+  Tcb.SackSeq = 7000;
+
+  ASSERT_EQ (Build (), TCP_OPTION_SACK_ALIGNED_LEN + 4 * TCP_OPTION_SACK_BLOCK_LEN);
+  ExpectSack (0, Blocks, ARRAY_SIZE (Blocks));
+}
+
+// Test that the blocks leave room for the timestamp option.
+TEST_F (TcpBuildOptionTest, FewerBlocksWithTimestamp) {
+  CONST TCP_SEQNO  Blocks[][2] = {
+    { 5000, 5100 },
+    { 2000, 2100 },
+    { 3000, 3100 }
+  };
+  TCP_SEQNO        Seq;
+
+  for (Seq = 2000; Seq <= 6000; Seq += 1000) {
+    QueueSegment (Seq, 100);
+  }
+
+  Tcb.SackSeq = 5000;
+  TCP_SET_FLG (Tcb.CtrlFlag, TCP_CTRL_SND_TS);
+
+  //
+  // The SACK option is added in front of the timestamp option.
+  //
+  ASSERT_EQ (Build (), TCP_OPTION_TS_ALIGNED_LEN + TCP_OPTION_SACK_ALIGNED_LEN + 3 * TCP_OPTION_SACK_BLOCK_LEN);
+  ExpectSack (0, Blocks, ARRAY_SIZE (Blocks));
+  EXPECT_EQ (GetUint32 (TCP_OPTION_SACK_ALIGNED_LEN + 3 * TCP_OPTION_SACK_BLOCK_LEN), (UINT32)TCP_OPTION_TS_FAST);
+}
@@ -235,6 +235,8 @@ TcpDriverEntryPoint (
   mTcp4RandomPort = (UINT16)(TCP_PORT_KNOWN + (Random % TCP_PORT_KNOWN));
   mTcp6RandomPort = mTcp4RandomPort;
 
+  NetbufInstallStatistics (ImageHandle);
+
   return EFI_SUCCESS;
 }
 
@@ -1477,6 +1477,8 @@ StepSix:
       goto RESET_THEN_DROP;
     }
 
+    Tcb->SackSeq = Seg->Seq;
+
     if (TcpQueueData (Tcb, Nbuf) == 0) {
       DEBUG (
         (DEBUG_ERROR,
@@ -64,6 +64,51 @@ TcpPutUint32 (
   CopyMem (Buf, &Data, sizeof (UINT32));
 }
 
+/**
+  Get the next block of contiguous data in the reassemble queue.
+
+  @param[in]       Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in, out]  Entry   On input, the entry of the reassemble queue to start
+                           from. On output, the entry following the block.
+  @param[out]      Left    The sequence number of the first byte of the block.
+  @param[out]      Right   The sequence number following the last byte of the block.
+
+  @retval TRUE             A block is returned.
+  @retval FALSE            There are no more blocks.
+
+**/
+BOOLEAN
+TcpGetSackBlock (
+  IN     TCP_CB      *Tcb,
+  IN OUT LIST_ENTRY  **Entry,
+  OUT    TCP_SEQNO   *Left,
+  OUT    TCP_SEQNO   *Right
+  )
+{
+  TCP_SEG  *Seg;
+
+  if (*Entry == &Tcb->RcvQue) {
+    return FALSE;
+  }
+
+  Seg    = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (*Entry, NET_BUF, List));
+  *Left  = Seg->Seq;
+  *Right = Seg->End;
+
+  for (*Entry = (*Entry)->ForwardLink; *Entry != &Tcb->RcvQue; *Entry = (*Entry)->ForwardLink) {
+    Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (*Entry, NET_BUF, List));
+    if (TCP_SEQ_GT (Seg->Seq, *Right)) {
+      break;
+    }
+
+    if (TCP_SEQ_GT (Seg->End, *Right)) {
+      *Right = Seg->End;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
   Compute the window scale value according to the given buffer size.
 
@@ -160,6 +205,28 @@ TcpSynBuildOption (
     TcpPutUint32 (Data, TCP_OPTION_WS_FAST | TcpComputeScale (Tcb));
   }
 
+  //
+  // Build SACK permitted option, only when configured to
+  // use SACK, and either we are doing active open or we
+  // have received SACK permitted option from peer.
+  //
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK) &&
+      (!TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_ACK) ||
+       TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_SACK))
+      )
+  {
+    Data = NetbufAllocSpace (
+             Nbuf,
+             TCP_OPTION_SACK_PERM_ALIGNED_LEN,
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+
+    Len += TCP_OPTION_SACK_PERM_ALIGNED_LEN;
+    TcpPutUint32 (Data, TCP_OPTION_SACK_PERM_FAST);
+  }
+
   //
   // Build the MSS option.
   //
@@ -187,11 +254,19 @@ TcpBuildOption (
   IN NET_BUF  *Nbuf
   )
 {
-  UINT8   *Data;
-  UINT16  Len;
+  UINT8       *Data;
+  UINT16      Len;
+  LIST_ENTRY  *Entry;
+  TCP_SEQNO   Left[TCP_OPTION_SACK_MAX_BLOCK];
+  TCP_SEQNO   Right[TCP_OPTION_SACK_MAX_BLOCK];
+  UINTN       MaxBlock;
+  UINTN       Count;
+  UINTN       Index;
+  UINT32      DataLen;
 
   ASSERT ((Tcb != NULL) && (Nbuf != NULL) && (Nbuf->Tcp == NULL));
-  Len = 0;
+  Len     = 0;
+  DataLen = Nbuf->TotalSize;
 
   //
   // Build the Timestamp option.
@@ -214,6 +289,56 @@ TcpBuildOption (
     TcpPutUint32 (Data + 8, Tcb->TsRecent);
   }
 
+  //
+  // Build the SACK option to report the out-of-order data
+  // in the reassemble queue. It is only added to segments
+  // without data, so that it doesn't reduce the SndMss.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_SACK) &&
+      !TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_RST) &&
+      (DataLen == 0) &&
+      !IsListEmpty (&Tcb->RcvQue)
+      )
+  {
+    MaxBlock = (TCP_OPTION_MAX_LEN - Len - TCP_OPTION_SACK_ALIGNED_LEN) / TCP_OPTION_SACK_BLOCK_LEN;
+    MaxBlock = MIN (MaxBlock, TCP_OPTION_SACK_MAX_BLOCK);
+
+    //
+    // The first block must be the one that contains the
+    // latest received segment, per RFC2018 section 4.
+    //
+    Count = 0;
+    Entry = Tcb->RcvQue.ForwardLink;
+    while (TcpGetSackBlock (Tcb, &Entry, &Left[0], &Right[0])) {
+      if (TCP_SEQ_LEQ (Left[0], Tcb->SackSeq) && TCP_SEQ_LT (Tcb->SackSeq, Right[0])) {
+        Count = 1;
+        break;
+      }
+    }
+
+    Entry = Tcb->RcvQue.ForwardLink;
+    while ((Count < MaxBlock) && TcpGetSackBlock (Tcb, &Entry, &Left[Count], &Right[Count])) {
+      if ((Count == 0) || (Left[Count] != Left[0])) {
+        Count++;
+      }
+    }
+
+    Data = NetbufAllocSpace (
+             Nbuf,
+             (UINT32)(TCP_OPTION_SACK_ALIGNED_LEN + Count * TCP_OPTION_SACK_BLOCK_LEN),
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+    Len += (UINT16)(TCP_OPTION_SACK_ALIGNED_LEN + Count * TCP_OPTION_SACK_BLOCK_LEN);
+
+    TcpPutUint32 (Data, TCP_OPTION_SACK_FAST | (UINT32)(Count * TCP_OPTION_SACK_BLOCK_LEN + 2));
+    for (Index = 0; Index < Count; Index++) {
+      TcpPutUint32 (Data + TCP_OPTION_SACK_ALIGNED_LEN + Index * TCP_OPTION_SACK_BLOCK_LEN, Left[Index]);
+      TcpPutUint32 (Data + TCP_OPTION_SACK_ALIGNED_LEN + Index * TCP_OPTION_SACK_BLOCK_LEN + 4, Right[Index]);
+    }
+  }
+
   return Len;
 }
 
@@ -311,6 +436,21 @@ TcpParseOption (
         Cur += TCP_OPTION_TS_LEN;
         break;
 
+      case TCP_OPTION_SACK_PERM:
+        if (TotalLen - Cur < TCP_OPTION_SACK_PERM_LEN) {
+          return -1;
+        }
+
+        Len = Head[Cur + 1];
+        if (Len != TCP_OPTION_SACK_PERM_LEN) {
+          return -1;
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK_PERM);
+
+        Cur += TCP_OPTION_SACK_PERM_LEN;
+        break;
+
       case TCP_OPTION_NOP:
         Cur++;
         break;
@@ -576,6 +576,8 @@ Udp4DriverEntryPoint (
              &gUdp4ComponentName2
              );
   if (!EFI_ERROR (Status)) {
+    NetbufInstallStatistics (ImageHandle);
+
     //
     // Initialize the UDP random port.
     //
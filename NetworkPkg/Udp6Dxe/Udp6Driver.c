@@ -617,6 +617,8 @@ Udp6DriverEntryPoint (
              &gUdp6ComponentName2
              );
   if (!EFI_ERROR (Status)) {
+    NetbufInstallStatistics (ImageHandle);
+
     //
     // Initialize the UDP random port.
     //
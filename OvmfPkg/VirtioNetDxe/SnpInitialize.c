@@ -341,9 +341,11 @@ VirtioNetInitRx (
 
   //
   // Limit the number of pending RX packets if the queue is big. The division
-  // by two is due to the above "two descriptors per packet" trait.
+  // by two is due to the above "two descriptors per packet" trait. The limit is
+  // higher than for TX, so that a burst of incoming frames, such as a full TCP
+  // receive window, is not dropped by the host.
   //
-  RxAlwaysPending = (UINT16)MIN (Dev->RxRing.QueueSize / 2, VNET_MAX_PENDING);
+  RxAlwaysPending = (UINT16)MIN (Dev->RxRing.QueueSize / 2, VNET_MAX_RX_PENDING);
 
   //
   // The RxBuf is shared between guest and hypervisor, use
@@ -425,6 +427,7 @@ VirtioNetInitRx (
   //
   MemoryFence ();
   *Dev->RxRing.Avail.Idx = RxAlwaysPending;
+  Dev->RxAvailIdx        = RxAlwaysPending;
 
   //
   // At this point reception may already be running. In order to make it sure,
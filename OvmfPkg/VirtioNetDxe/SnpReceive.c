@@ -73,7 +73,6 @@ VirtioNetReceive (
   UINT32      RxLen;
   UINTN       OrigBufferSize;
   UINT8       *RxPtr;
-  UINT16      AvailIdx;
   EFI_STATUS  NotifyStatus;
   UINTN       RxBufOffset;
 
@@ -168,15 +167,29 @@ RecycleDesc:
   //
   // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
   //
-  AvailIdx                                                   = *Dev->RxRing.Avail.Idx;
-  Dev->RxRing.Avail.Ring[AvailIdx++ % Dev->RxRing.QueueSize] =
+  // The descriptor is placed into the available ring right away, but the
+  // Index Field is only updated, and the device notified, once per batch of
+  // packets, or when there are no more packets to receive. The device keeps
+  // enough other buffers in the meantime.
+  //
+  Dev->RxRing.Avail.Ring[Dev->RxAvailIdx++ % Dev->RxRing.QueueSize] =
     (UINT16)DescIdx;
 
   MemoryFence ();
-  *Dev->RxRing.Avail.Idx = AvailIdx;
+  RxCurUsed = *Dev->RxRing.Used.Idx;
+  MemoryFence ();
+
+  if ((Dev->RxLastUsed != RxCurUsed) &&
+      ((UINT16)(Dev->RxAvailIdx - *Dev->RxRing.Avail.Idx) <
+       VNET_RX_RECYCLE_BATCH))
+  {
+    goto Exit;
+  }
 
   MemoryFence ();
-  NotifyStatus = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
+  *Dev->RxRing.Avail.Idx = Dev->RxAvailIdx;
+
+  NotifyStatus = VirtioNetNotifyQueue (Dev, &Dev->RxRing, VIRTIO_NET_Q_RX);
   if (!EFI_ERROR (Status)) {
     // earlier error takes precedence
     Status = NotifyStatus;
@@ -8,6 +8,7 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
 
 #include "VirtioNet.h"
@@ -103,6 +104,43 @@ VirtioNetUninitRing (
   VirtioRingUninit (Dev->VirtIo, Ring);
 }
 
+/**
+  Notify the device of new buffers in the available ring, unless the device
+  has asked not to be notified.
+
+  Each notification is a trap to the hypervisor. The device sets
+  VRING_USED_F_NO_NOTIFY while it is processing the ring anyway, for example
+  when a vhost-net backend is busy, in which case the notification is skipped.
+
+  The caller is responsible for having updated the Index Field of the
+  available ring before calling this function.
+
+  @param[in] Dev         The VNET_DEV driver instance using the ring.
+  @param[in] Ring        The virtio ring whose available ring was updated.
+  @param[in] QueueIndex  The index of the virtqueue to notify.
+
+  @retval EFI_SUCCESS  The device was notified, or did not want to be.
+  @return              Status codes from VIRTIO_DEVICE_PROTOCOL.SetQueueNotify.
+*/
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN VNET_DEV  *Dev,
+  IN VRING     *Ring,
+  IN UINT16    QueueIndex
+  )
+{
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device
+  //
+  MemoryFence ();
+  if ((*Ring->Used.Flags & VRING_USED_F_NO_NOTIFY) != 0) {
+    return EFI_SUCCESS;
+  }
+
+  return Dev->VirtIo->SetQueueNotify (Dev->VirtIo, QueueIndex);
+}
+
 /**
   Map Caller-supplied TxBuf buffer to the device-mapped address
 
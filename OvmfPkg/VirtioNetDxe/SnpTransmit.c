@@ -173,8 +173,7 @@ VirtioNetTransmit (
   MemoryFence ();
   *Dev->TxRing.Avail.Idx = AvailIdx;
 
-  MemoryFence ();
-  Status = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_TX);
+  Status = VirtioNetNotifyQueue (Dev, &Dev->TxRing, VIRTIO_NET_Q_TX);
 
 Exit:
   gBS->RestoreTPL (OldTpl);
@@ -27,7 +27,14 @@
 //
 // maximum number of pending packets, separately for each direction
 //
-#define VNET_MAX_PENDING  64
+#define VNET_MAX_PENDING     64
+#define VNET_MAX_RX_PENDING  256
+
+//
+// maximum number of received packets whose descriptors are recycled before
+// they are exposed to the device again
+//
+#define VNET_RX_RECYCLE_BATCH  16
 
 //
 // State diagram:
@@ -82,6 +89,7 @@ typedef struct {
                                                   // VirtioNetInitRing
   UINT8                          *RxBuf;          // VirtioNetInitRx
   UINT16                         RxLastUsed;      // VirtioNetInitRx
+  UINT16                         RxAvailIdx;      // VirtioNetInitRx
   UINTN                          RxBufNrPages;    // VirtioNetInitRx
   EFI_PHYSICAL_ADDRESS           RxBufDeviceBase; // VirtioNetInitRx
   VOID                           *RxBufMap;       // VirtioNetInitRx
@@ -275,6 +283,14 @@ VirtioNetUninitRing (
   IN     VOID      *RingMap
   );
 
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN VNET_DEV  *Dev,
+  IN VRING     *Ring,
+  IN UINT16    QueueIndex
+  );
+
 //
 // utility functions to map caller-supplied Tx buffer system physical address
 // to a device address and vice versa
@@ -0,0 +1,156 @@
+/** @file
+  UEFI Application to measure the speedup of MpTaskPoolLib.
+
+  The application runs the same batch of CRC32 tasks on the BSP alone and
+  through MpTaskPoolRun(), and prints both times. On EmulatorPkg the number of
+  APs is set by PcdEmuApCount.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/MpTaskPoolLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiLib.h>
+
+#define BENCHMARK_TASK_COUNT   256
+#define BENCHMARK_BUFFER_SIZE  SIZE_64KB
+#define BENCHMARK_PASS_COUNT   16
+
+typedef struct {
+  UINT8     *Buffer;
+  UINT32    Crc;
+} BENCHMARK_TASK_CONTEXT;
+
+/**
+  Compute the CRC32 of the task buffer several times.
+
+  @param[in, out] Context   Pointer to a BENCHMARK_TASK_CONTEXT.
+
+**/
+VOID
+EFIAPI
+BenchmarkTask (
+  IN OUT VOID  *Context
+  )
+{
+  BENCHMARK_TASK_CONTEXT  *TaskContext;
+  UINTN                   Pass;
+
+  TaskContext = (BENCHMARK_TASK_CONTEXT *)Context;
+  for (Pass = 0; Pass < BENCHMARK_PASS_COUNT; Pass++) {
+    TaskContext->Crc = CalculateCrc32 (TaskContext->Buffer, BENCHMARK_BUFFER_SIZE);
+  }
+}
+
+/**
+  Return the time elapsed between two performance counter values.
+
+  @param[in] Start   Performance counter value at the start.
+  @param[in] End     Performance counter value at the end.
+
+  @return The elapsed time in microseconds.
+
+**/
+UINT64
+BenchmarkElapsedTime (
+  IN UINT64  Start,
+  IN UINT64  End
+  )
+{
+  UINT64  StartValue;
+  UINT64  EndValue;
+
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (StartValue > EndValue) {
+    return DivU64x32 (GetTimeInNanoSecond (Start - End), 1000);
+  }
+
+  return DivU64x32 (GetTimeInNanoSecond (End - Start), 1000);
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS           The entry point is executed successfully.
+  @retval EFI_OUT_OF_RESOURCES  The task buffers could not be allocated.
+  @retval other                 MpTaskPoolRun() failed.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS              Status;
+  MP_TASK                 *Tasks;
+  BENCHMARK_TASK_CONTEXT  *Contexts;
+  UINT8                   *Buffers;
+  UINTN                   Index;
+  UINT64                  Start;
+  UINT64                  SerialTime;
+  UINT64                  PoolTime;
+
+  Tasks    = AllocateZeroPool (BENCHMARK_TASK_COUNT * sizeof (MP_TASK));
+  Contexts = AllocateZeroPool (BENCHMARK_TASK_COUNT * sizeof (BENCHMARK_TASK_CONTEXT));
+  Buffers  = AllocatePages (EFI_SIZE_TO_PAGES (BENCHMARK_TASK_COUNT * BENCHMARK_BUFFER_SIZE));
+  if ((Tasks == NULL) || (Contexts == NULL) || (Buffers == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  for (Index = 0; Index < BENCHMARK_TASK_COUNT; Index++) {
+    SetMem (&Buffers[Index * BENCHMARK_BUFFER_SIZE], BENCHMARK_BUFFER_SIZE, (UINT8)Index);
+    Contexts[Index].Buffer = &Buffers[Index * BENCHMARK_BUFFER_SIZE];
+    Tasks[Index].Procedure = BenchmarkTask;
+    Tasks[Index].Context   = &Contexts[Index];
+  }
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < BENCHMARK_TASK_COUNT; Index++) {
+    BenchmarkTask (&Contexts[Index]);
+  }
+
+  SerialTime = BenchmarkElapsedTime (Start, GetPerformanceCounter ());
+
+  Start    = GetPerformanceCounter ();
+  Status   = MpTaskPoolRun (Tasks, BENCHMARK_TASK_COUNT);
+  PoolTime = BenchmarkElapsedTime (Start, GetPerformanceCounter ());
+  if (EFI_ERROR (Status)) {
+    Print (L"MpTaskPoolRun failed: %r\n", Status);
+    goto Done;
+  }
+
+  Print (L"%d tasks of %d KB x %d CRC32 passes\n", BENCHMARK_TASK_COUNT, BENCHMARK_BUFFER_SIZE / SIZE_1KB, BENCHMARK_PASS_COUNT);
+  Print (L"  BSP only:      %ld us\n", SerialTime);
+  Print (L"  MpTaskPoolRun: %ld us\n", PoolTime);
+  if (PoolTime != 0) {
+    Print (L"  Speedup:       %ld.%02ld\n", DivU64x64Remainder (SerialTime, PoolTime, NULL), DivU64x64Remainder (MultU64x32 (SerialTime, 100), PoolTime, NULL) % 100);
+  }
+
+Done:
+  if (Buffers != NULL) {
+    FreePages (Buffers, EFI_SIZE_TO_PAGES (BENCHMARK_TASK_COUNT * BENCHMARK_BUFFER_SIZE));
+  }
+
+  if (Contexts != NULL) {
+    FreePool (Contexts);
+  }
+
+  if (Tasks != NULL) {
+    FreePool (Tasks);
+  }
+
+  return Status;
+}
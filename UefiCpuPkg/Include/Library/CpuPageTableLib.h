@@ -111,6 +111,65 @@ PageTableMap (
   OUT    BOOLEAN             *IsModified   OPTIONAL
   );
 
+typedef struct {
+  UINT64                LinearAddress;
+  UINT64                Length;
+  IA32_MAP_ATTRIBUTE    Attribute;
+  IA32_MAP_ATTRIBUTE    Mask;
+} IA32_MAP_REQUEST;
+
+/**
+  Create or update page table to map a list of linear address ranges, each with its own attribute.
+
+  The ranges are applied in array order, so a later range overrides the attribute of an earlier range
+  where they overlap. The caller only needs to flush the TLB once after this function returns with
+  IsModified set to TRUE, instead of once per range.
+
+  The parameters of all ranges are checked before the page table is modified. The ranges are then mapped
+  one after the other, and the buffer size needed by each range is checked on the page table updated by
+  the earlier ranges, so RETURN_BUFFER_TOO_SMALL may be returned after some ranges are mapped. Calling
+  this function again with the same Requests and a larger buffer results in the same page table as one
+  successful call.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      Requests       Array of linear address ranges, attributes and masks to map.
+                                 See PageTableMap() for the meaning of each field.
+  @param[in]      RequestCount   Number of entries in Requests.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+                                 IsModified is also valid when an error is returned.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable or BufferSize is NULL.
+  @retval RETURN_INVALID_PARAMETER  Requests is NULL and RequestCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  Any range in Requests is invalid. See PageTableMap() for the checks done on each range.
+  @retval RETURN_INVALID_PARAMETER  A range conflicts with the page table after the earlier ranges in Requests are mapped.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or all ranges have a Length of 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRanges (
+  IN OUT UINTN             *PageTable  OPTIONAL,
+  IN     PAGING_MODE       PagingMode,
+  IN     VOID              *Buffer,
+  IN OUT UINTN             *BufferSize,
+  IN     IA32_MAP_REQUEST  *Requests,
+  IN     UINTN             RequestCount,
+  OUT    BOOLEAN           *IsModified   OPTIONAL
+  );
+
 typedef struct {
   UINT64                LinearAddress;
   UINT64                Length;
@@ -0,0 +1,77 @@
+/** @file
+  Header file for MP Task Pool Library.
+
+  The library runs a batch of independent tasks on the application processors
+  through the MP Services Protocol in DXE, or the MP Services2 PPI in PEI,
+  balancing the load between processors by work stealing.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef MP_TASK_POOL_LIB_H_
+#define MP_TASK_POOL_LIB_H_
+
+/**
+  Prototype of a task run by MpTaskPoolRun().
+
+  The function runs on an AP, or on the BSP when no AP is available, so it
+  must only call services that are safe to call on an AP. In PEI, this rules
+  out the PEI Services.
+
+  @param[in, out] Context   The context that was registered with the task.
+
+**/
+typedef
+VOID
+(EFIAPI *MP_TASK_PROCEDURE)(
+  IN OUT VOID  *Context
+  );
+
+typedef struct {
+  //
+  // Function to run.
+  //
+  MP_TASK_PROCEDURE    Procedure;
+  //
+  // Parameter passed to Procedure.
+  //
+  VOID                 *Context;
+} MP_TASK;
+
+/**
+  Run a batch of independent tasks on all enabled application processors.
+
+  The tasks are divided into one queue per processor. Every AP first runs the
+  tasks in its own queue and then steals tasks from the queues of the other
+  processors, so that processors which finish early, or which are disabled,
+  do not hold back the batch. The function returns after all tasks have run.
+
+  Tasks must not depend on each other. The order in which tasks run is not
+  defined.
+
+  If the MP services are not available, or if StartupAllAPs() can not
+  dispatch the APs, the remaining tasks are run on the calling processor.
+  The per-processor queues are allocated in pages, so the PEI instance can only
+  be used after permanent memory is installed.
+
+  @param[in] Tasks          Array of tasks to run.
+  @param[in] TaskCount      Number of entries in Tasks.
+
+  @retval EFI_SUCCESS            All tasks have run.
+  @retval EFI_INVALID_PARAMETER  Tasks is NULL and TaskCount is not 0.
+  @retval EFI_INVALID_PARAMETER  TaskCount is larger than MAX_UINT32.
+  @retval EFI_INVALID_PARAMETER  A task has a NULL Procedure.
+  @retval EFI_OUT_OF_RESOURCES   There are not enough resources to set up the
+                                 per-processor queues. No task has run.
+
+**/
+EFI_STATUS
+EFIAPI
+MpTaskPoolRun (
+  IN MP_TASK  *Tasks,
+  IN UINTN    TaskCount
+  );
+
+#endif
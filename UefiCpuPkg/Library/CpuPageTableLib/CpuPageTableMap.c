@@ -648,68 +648,32 @@ PageTableLibMapInLevel (
 }
 
 /**
-  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+  Check the parameters of one linear address range to map.
 
-  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
-                                 If not pointer to NULL, the value it points to won't be changed in this function.
-  @param[in]      PagingMode     The paging mode.
-  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
-  @param[in, out] BufferSize     The buffer size.
-                                 On return, the remaining buffer size.
-                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
-                                 BufferSize in the second call to this API.
-  @param[in]      LinearAddress  The start of the linear address range.
-  @param[in]      Length         The length of the linear address range.
-  @param[in]      Attribute      The attribute of the linear address range.
-                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
-                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
-                                 when a new physical base address is set.
-  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
-  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
-                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
-                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+  @param[in] PagingMode     The paging mode.
+  @param[in] LinearAddress  The start of the linear address range.
+  @param[in] Length         The length of the linear address range.
+  @param[in] Attribute      The attribute of the linear address range.
+  @param[in] Mask           The mask used for attribute.
 
   @retval RETURN_UNSUPPORTED        PagingMode is not supported.
-  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
-  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
-                                    BufferSize is updated to indicate the expected buffer size.
-                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
-  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+  @retval RETURN_INVALID_PARAMETER  Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  LinearAddress or Length is not multiple of 4KB.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, some attributes other than Present are provided.
+  @retval RETURN_INVALID_PARAMETER  The range exceeds the maximum linear address of PagingMode.
+  @retval RETURN_SUCCESS            The parameters are valid.
 **/
 RETURN_STATUS
-EFIAPI
-PageTableMap (
-  IN OUT UINTN               *PageTable  OPTIONAL,
-  IN     PAGING_MODE         PagingMode,
-  IN     VOID                *Buffer,
-  IN OUT UINTN               *BufferSize,
-  IN     UINT64              LinearAddress,
-  IN     UINT64              Length,
-  IN     IA32_MAP_ATTRIBUTE  *Attribute,
-  IN     IA32_MAP_ATTRIBUTE  *Mask,
-  OUT    BOOLEAN             *IsModified   OPTIONAL
+PageTableLibCheckMapRange (
+  IN PAGING_MODE         PagingMode,
+  IN UINT64              LinearAddress,
+  IN UINT64              Length,
+  IN IA32_MAP_ATTRIBUTE  *Attribute,
+  IN IA32_MAP_ATTRIBUTE  *Mask
   )
 {
-  RETURN_STATUS       Status;
-  IA32_PAGING_ENTRY   TopPagingEntry;
-  INTN                RequiredSize;
-  UINT64              MaxLinearAddress;
-  IA32_PAGE_LEVEL     MaxLevel;
-  IA32_PAGE_LEVEL     MaxLeafLevel;
-  IA32_MAP_ATTRIBUTE  ParentAttribute;
-  BOOLEAN             LocalIsModified;
-  UINTN               Index;
-  IA32_PAGING_ENTRY   *PagingEntry;
-  UINT8               BufferInStack[SIZE_4KB - 1 + MAX_PAE_PDPTE_NUM * sizeof (IA32_PAGING_ENTRY)];
-
-  if (Length == 0) {
-    return RETURN_SUCCESS;
-  }
+  UINT64           MaxLinearAddress;
+  IA32_PAGE_LEVEL  MaxLevel;
 
   if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
     //
@@ -718,14 +682,7 @@ PageTableMap (
     return RETURN_UNSUPPORTED;
   }
 
-  if ((PageTable == NULL) || (BufferSize == NULL) || (Attribute == NULL) || (Mask == NULL)) {
-    return RETURN_INVALID_PARAMETER;
-  }
-
-  if (*BufferSize % SIZE_4KB != 0) {
-    //
-    // BufferSize should be multiple of 4K.
-    //
+  if ((Attribute == NULL) || (Mask == NULL)) {
     return RETURN_INVALID_PARAMETER;
   }
 
@@ -736,10 +693,6 @@ PageTableMap (
     return RETURN_INVALID_PARAMETER;
   }
 
-  if ((*BufferSize != 0) && (Buffer == NULL)) {
-    return RETURN_INVALID_PARAMETER;
-  }
-
   //
   // If to map [LinearAddress, LinearAddress + Length] as non-present,
   // all attributes except Present should not be provided.
@@ -748,7 +701,6 @@ PageTableMap (
     return RETURN_INVALID_PARAMETER;
   }
 
-  MaxLeafLevel     = (IA32_PAGE_LEVEL)(UINT8)PagingMode;
   MaxLevel         = (IA32_PAGE_LEVEL)(UINT8)(PagingMode >> 8);
   MaxLinearAddress = (PagingMode == PagingPae) ? LShiftU64 (1, 32) : LShiftU64 (1, 12 + MaxLevel * 9);
 
@@ -759,6 +711,56 @@ PageTableMap (
     return RETURN_INVALID_PARAMETER;
   }
 
+  return RETURN_SUCCESS;
+}
+
+/**
+  Query the buffer size needed to map one linear address range, or map the range.
+
+  The parameters of the range must have been checked by PageTableLibCheckMapRange().
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Modify         FALSE to only increase BufferSize by the required buffer size.
+                                 TRUE to update the page table using Buffer.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     When Modify is FALSE, decreased by the required buffer size (the value is negative).
+                                 When Modify is TRUE, the remaining buffer size.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+  @param[in]      Mask           The mask used for attribute.
+  @param[in, out] IsModified     Set to TRUE if the page table is modified.
+
+  @retval RETURN_INVALID_PARAMETER  The attribute conflicts with the existing page table.
+  @retval RETURN_SUCCESS            The required size is returned or the page table is updated.
+**/
+RETURN_STATUS
+PageTableLibMapRange (
+  IN OUT UINTN               *PageTable,
+  IN     PAGING_MODE         PagingMode,
+  IN     BOOLEAN             Modify,
+  IN     VOID                *Buffer,
+  IN OUT INTN                *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  IN OUT BOOLEAN             *IsModified
+  )
+{
+  RETURN_STATUS       Status;
+  IA32_PAGING_ENTRY   TopPagingEntry;
+  IA32_PAGE_LEVEL     MaxLevel;
+  IA32_PAGE_LEVEL     MaxLeafLevel;
+  IA32_MAP_ATTRIBUTE  ParentAttribute;
+  UINTN               Index;
+  IA32_PAGING_ENTRY   *PagingEntry;
+  UINT8               BufferInStack[SIZE_4KB - 1 + MAX_PAE_PDPTE_NUM * sizeof (IA32_PAGING_ENTRY)];
+
+  MaxLeafLevel = (IA32_PAGE_LEVEL)(UINT8)PagingMode;
+  MaxLevel     = (IA32_PAGE_LEVEL)(UINT8)(PagingMode >> 8);
+
   TopPagingEntry.Uintn = *PageTable;
   if (TopPagingEntry.Uintn != 0) {
     if (PagingMode == PagingPae) {
@@ -782,12 +784,6 @@ PageTableMap (
     TopPagingEntry.Pce.Nx             = 0;
   }
 
-  if (IsModified == NULL) {
-    IsModified = &LocalIsModified;
-  }
-
-  *IsModified = FALSE;
-
   ParentAttribute.Uint64                       = 0;
   ParentAttribute.Bits.PageTableBaseAddressLow = 1;
   ParentAttribute.Bits.Present                 = 1;
@@ -795,50 +791,12 @@ PageTableMap (
   ParentAttribute.Bits.UserSupervisor          = 1;
   ParentAttribute.Bits.Nx                      = 0;
 
-  //
-  // Query the required buffer size without modifying the page table.
-  //
-  RequiredSize = 0;
-  Status       = PageTableLibMapInLevel (
-                   &TopPagingEntry,
-                   &ParentAttribute,
-                   FALSE,
-                   NULL,
-                   &RequiredSize,
-                   MaxLevel,
-                   MaxLeafLevel,
-                   LinearAddress,
-                   Length,
-                   0,
-                   Attribute,
-                   Mask,
-                   IsModified
-                   );
-  ASSERT (*IsModified == FALSE);
-  if (RETURN_ERROR (Status)) {
-    return Status;
-  }
-
-  RequiredSize = -RequiredSize;
-
-  if ((UINTN)RequiredSize > *BufferSize) {
-    *BufferSize = RequiredSize;
-    return RETURN_BUFFER_TOO_SMALL;
-  }
-
-  if ((RequiredSize != 0) && (Buffer == NULL)) {
-    return RETURN_INVALID_PARAMETER;
-  }
-
-  //
-  // Update the page table when the supplied buffer is sufficient.
-  //
   Status = PageTableLibMapInLevel (
              &TopPagingEntry,
              &ParentAttribute,
-             TRUE,
+             Modify,
              Buffer,
-             (INTN *)BufferSize,
+             BufferSize,
              MaxLevel,
              MaxLeafLevel,
              LinearAddress,
@@ -849,7 +807,7 @@ PageTableMap (
              IsModified
              );
 
-  if (!RETURN_ERROR (Status)) {
+  if (Modify && !RETURN_ERROR (Status)) {
     PagingEntry = (IA32_PAGING_ENTRY *)(UINTN)(TopPagingEntry.Uintn & IA32_PE_BASE_ADDRESS_MASK_40);
 
     if (PagingMode == PagingPae) {
@@ -881,3 +839,250 @@ PageTableMap (
 
   return Status;
 }
+
+/**
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
+                                 when a new physical base address is set.
+  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMap (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  )
+{
+  IA32_MAP_REQUEST  Request;
+
+  if (Length == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  if ((Attribute == NULL) || (Mask == NULL)) {
+    //
+    // Attribute and Mask are copied into the request below, so check them here.
+    //
+    if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
+      return RETURN_UNSUPPORTED;
+    }
+
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Request.LinearAddress = LinearAddress;
+  Request.Length        = Length;
+  Request.Attribute     = *Attribute;
+  Request.Mask          = *Mask;
+
+  return PageTableMapRanges (PageTable, PagingMode, Buffer, BufferSize, &Request, 1, IsModified);
+}
+
+/**
+  Create or update page table to map a list of linear address ranges, each with its own attribute.
+
+  The ranges are applied in array order, so a later range overrides the attribute of an earlier range
+  where they overlap. The caller only needs to flush the TLB once after this function returns with
+  IsModified set to TRUE, instead of once per range.
+
+  The parameters of all ranges are checked before the page table is modified. The ranges are then mapped
+  one after the other, and the buffer size needed by each range is checked on the page table updated by
+  the earlier ranges, so RETURN_BUFFER_TOO_SMALL may be returned after some ranges are mapped. Calling
+  this function again with the same Requests and a larger buffer results in the same page table as one
+  successful call.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      Requests       Array of linear address ranges, attributes and masks to map.
+                                 See PageTableMap() for the meaning of each field.
+  @param[in]      RequestCount   Number of entries in Requests.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+                                 IsModified is also valid when an error is returned.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable or BufferSize is NULL.
+  @retval RETURN_INVALID_PARAMETER  Requests is NULL and RequestCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  Any range in Requests is invalid. See PageTableMap() for the checks done on each range.
+  @retval RETURN_INVALID_PARAMETER  A range conflicts with the page table after the earlier ranges in Requests are mapped.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or all ranges have a Length of 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRanges (
+  IN OUT UINTN             *PageTable  OPTIONAL,
+  IN     PAGING_MODE       PagingMode,
+  IN     VOID              *Buffer,
+  IN OUT UINTN             *BufferSize,
+  IN     IA32_MAP_REQUEST  *Requests,
+  IN     UINTN             RequestCount,
+  OUT    BOOLEAN           *IsModified   OPTIONAL
+  )
+{
+  RETURN_STATUS  Status;
+  INTN           RequiredSize;
+  INTN           RangeSize;
+  BOOLEAN        LocalIsModified;
+  UINTN          Index;
+  UINTN          Index2;
+
+  if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
+    //
+    // 32bit paging is never supported.
+    //
+    return RETURN_UNSUPPORTED;
+  }
+
+  if ((PageTable == NULL) || (BufferSize == NULL) || ((Requests == NULL) && (RequestCount != 0))) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (*BufferSize % SIZE_4KB != 0) {
+    //
+    // BufferSize should be multiple of 4K.
+    //
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if ((*BufferSize != 0) && (Buffer == NULL)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < RequestCount; Index++) {
+    Status = PageTableLibCheckMapRange (
+               PagingMode,
+               Requests[Index].LinearAddress,
+               Requests[Index].Length,
+               &Requests[Index].Attribute,
+               &Requests[Index].Mask
+               );
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  if (IsModified == NULL) {
+    IsModified = &LocalIsModified;
+  }
+
+  *IsModified = FALSE;
+
+  for (Index = 0; Index < RequestCount; Index++) {
+    if (Requests[Index].Length == 0) {
+      continue;
+    }
+
+    //
+    // Query the required buffer size of the range on the page table updated by the earlier ranges.
+    // An earlier range may change the attribute of a large page that this range splits, so the
+    // size can not be calculated on the input page table.
+    //
+    RangeSize = 0;
+    Status    = PageTableLibMapRange (
+                  PageTable,
+                  PagingMode,
+                  FALSE,
+                  NULL,
+                  &RangeSize,
+                  Requests[Index].LinearAddress,
+                  Requests[Index].Length,
+                  &Requests[Index].Attribute,
+                  &Requests[Index].Mask,
+                  IsModified
+                  );
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    if ((UINTN)-RangeSize > *BufferSize) {
+      //
+      // Estimate the buffer size needed by the remaining ranges on the current page table.
+      // The ranges are not mapped one after the other here, so the estimation may be too small.
+      //
+      RequiredSize = RangeSize;
+      for (Index2 = Index + 1; Index2 < RequestCount; Index2++) {
+        if (Requests[Index2].Length != 0) {
+          PageTableLibMapRange (
+            PageTable,
+            PagingMode,
+            FALSE,
+            NULL,
+            &RequiredSize,
+            Requests[Index2].LinearAddress,
+            Requests[Index2].Length,
+            &Requests[Index2].Attribute,
+            &Requests[Index2].Mask,
+            IsModified
+            );
+        }
+      }
+
+      *BufferSize = -RequiredSize;
+      return RETURN_BUFFER_TOO_SMALL;
+    }
+
+    Status = PageTableLibMapRange (
+               PageTable,
+               PagingMode,
+               TRUE,
+               Buffer,
+               (INTN *)BufferSize,
+               Requests[Index].LinearAddress,
+               Requests[Index].Length,
+               &Requests[Index].Attribute,
+               &Requests[Index].Mask,
+               IsModified
+               );
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return RETURN_SUCCESS;
+}
@@ -821,6 +821,298 @@ TestCaseToCheckMapMaskAndAttr (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Check that PageTableMapRanges() creates the same page table as calling PageTableMap() for each range
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCaseMapRanges (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN             PageTable;
+  UINTN             BatchPageTable;
+  PAGING_MODE       PagingMode;
+  VOID              *Buffer;
+  UINTN             PageTableBufferSize;
+  IA32_MAP_REQUEST  Requests[4];
+  UINTN             Index;
+  IA32_MAP_ENTRY    *Map;
+  UINTN             MapCount;
+  IA32_MAP_ENTRY    *BatchMap;
+  UINTN             BatchMapCount;
+  BOOLEAN           IsModified;
+  RETURN_STATUS     Status;
+  UNIT_TEST_STATUS  TestStatus;
+
+  PagingMode = Paging4Level1GB;
+  ZeroMem (Requests, sizeof (Requests));
+
+  //
+  // Map [0, 1G] as present and read-write.
+  //
+  Requests[0].LinearAddress            = 0;
+  Requests[0].Length                   = SIZE_1GB;
+  Requests[0].Attribute.Bits.Present   = 1;
+  Requests[0].Attribute.Bits.ReadWrite = 1;
+  Requests[0].Mask.Uint64              = MAX_UINT64;
+
+  //
+  // Map [2M + 8K, 2M + 16K] as read-only, which splits the 1G page down to 4K pages.
+  //
+  Requests[1].LinearAddress       = SIZE_2MB + SIZE_8KB;
+  Requests[1].Length              = SIZE_8KB;
+  Requests[1].Mask.Bits.ReadWrite = 1;
+
+  //
+  // Map [512M, 512M + 2M] as non-executable.
+  //
+  Requests[2].LinearAddress     = SIZE_512MB;
+  Requests[2].Length            = SIZE_2MB;
+  Requests[2].Attribute.Bits.Nx = 1;
+  Requests[2].Mask.Bits.Nx      = 1;
+
+  //
+  // Map [4K, 8K] as not present.
+  //
+  Requests[3].LinearAddress     = SIZE_4KB;
+  Requests[3].Length            = SIZE_4KB;
+  Requests[3].Mask.Bits.Present = 1;
+
+  //
+  // Create the reference page table by mapping one range at a time.
+  //
+  PageTable = 0;
+  for (Index = 0; Index < ARRAY_SIZE (Requests); Index++) {
+    PageTableBufferSize = 0;
+    Status              = PageTableMap (
+                            &PageTable,
+                            PagingMode,
+                            NULL,
+                            &PageTableBufferSize,
+                            Requests[Index].LinearAddress,
+                            Requests[Index].Length,
+                            &Requests[Index].Attribute,
+                            &Requests[Index].Mask,
+                            NULL
+                            );
+    if (Status == RETURN_BUFFER_TOO_SMALL) {
+      Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+      UT_ASSERT_NOT_EQUAL (Buffer, NULL);
+      Status = PageTableMap (
+                 &PageTable,
+                 PagingMode,
+                 Buffer,
+                 &PageTableBufferSize,
+                 Requests[Index].LinearAddress,
+                 Requests[Index].Length,
+                 &Requests[Index].Attribute,
+                 &Requests[Index].Mask,
+                 NULL
+                 );
+    }
+
+    UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  }
+
+  //
+  // Create the same page table with one list of ranges.
+  // Requests[1] only applies to a region mapped by Requests[0], so the ranges are mapped
+  // one after the other and more than one call may be needed to supply enough buffer.
+  //
+  BatchPageTable      = 0;
+  PageTableBufferSize = 0;
+  Buffer              = NULL;
+  do {
+    if (PageTableBufferSize != 0) {
+      Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+      UT_ASSERT_NOT_EQUAL (Buffer, NULL);
+    }
+
+    Status = PageTableMapRanges (&BatchPageTable, PagingMode, Buffer, &PageTableBufferSize, Requests, ARRAY_SIZE (Requests), &IsModified);
+  } while (Status == RETURN_BUFFER_TOO_SMALL);
+
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  TestStatus = IsPageTableValid (BatchPageTable, PagingMode);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  //
+  // Both page tables should map the same ranges with the same attributes.
+  //
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Map    = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  BatchMapCount = 0;
+  Status        = PageTableParse (BatchPageTable, PagingMode, NULL, &BatchMapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  BatchMap = AllocatePages (EFI_SIZE_TO_PAGES (BatchMapCount * sizeof (IA32_MAP_ENTRY)));
+  Status   = PageTableParse (BatchPageTable, PagingMode, BatchMap, &BatchMapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  UT_ASSERT_EQUAL (BatchMapCount, MapCount);
+  UT_ASSERT_MEM_EQUAL (BatchMap, Map, MapCount * sizeof (IA32_MAP_ENTRY));
+
+  //
+  // The buffer of a range is checked before the range is mapped, so the page table must not be
+  // changed when the first range that changes it needs more buffer than supplied.
+  //
+  Requests[2].Attribute.Bits.Nx = 0;
+  Requests[2].Length            = SIZE_4KB;
+  PageTableBufferSize           = 0;
+  Status                        = PageTableMapRanges (&BatchPageTable, PagingMode, NULL, &PageTableBufferSize, &Requests[2], 2, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (PageTableBufferSize, SIZE_4KB);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+  Status = PageTableParse (BatchPageTable, PagingMode, BatchMap, &BatchMapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (BatchMapCount, MapCount);
+  UT_ASSERT_MEM_EQUAL (BatchMap, Map, MapCount * sizeof (IA32_MAP_ENTRY));
+
+  Requests[2].Attribute.Bits.Nx = 1;
+  Requests[2].Length            = SIZE_2MB;
+  PageTableBufferSize           = 0;
+  Status                        = PageTableMapRanges (&BatchPageTable, PagingMode, NULL, &PageTableBufferSize, Requests, ARRAY_SIZE (Requests), &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  Status = PageTableParse (BatchPageTable, PagingMode, BatchMap, &BatchMapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (BatchMapCount, MapCount);
+  UT_ASSERT_MEM_EQUAL (BatchMap, Map, MapCount * sizeof (IA32_MAP_ENTRY));
+
+  //
+  // An invalid range is rejected before any range is mapped.
+  //
+  Requests[0].Attribute.Bits.ReadWrite = 0;
+  Requests[3].LinearAddress            = 1;
+  PageTableBufferSize                  = 0;
+  Status                               = PageTableMapRanges (&BatchPageTable, PagingMode, NULL, &PageTableBufferSize, Requests, ARRAY_SIZE (Requests), &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_INVALID_PARAMETER);
+  Status = PageTableParse (BatchPageTable, PagingMode, BatchMap, &BatchMapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (BatchMapCount, MapCount);
+  UT_ASSERT_MEM_EQUAL (BatchMap, Map, MapCount * sizeof (IA32_MAP_ENTRY));
+
+  UT_ASSERT_EQUAL (PageTableMapRanges (&BatchPageTable, PagingMode, NULL, &PageTableBufferSize, NULL, 0, NULL), RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (PageTableMapRanges (&BatchPageTable, PagingMode, NULL, &PageTableBufferSize, NULL, 1, NULL), RETURN_INVALID_PARAMETER);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that PageTableMapRanges() asks for the buffer of a range that splits a page changed by an earlier range
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCaseMapOverlappingRanges (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN               PageTable;
+  PAGING_MODE         PagingMode;
+  VOID                *Buffer;
+  UINTN               PageTableBufferSize;
+  IA32_MAP_ATTRIBUTE  MapAttribute;
+  IA32_MAP_ATTRIBUTE  MapMask;
+  IA32_MAP_REQUEST    Requests[2];
+  IA32_MAP_ENTRY      Map[2];
+  UINTN               MapCount;
+  BOOLEAN             IsModified;
+  RETURN_STATUS       Status;
+  UNIT_TEST_STATUS    TestStatus;
+
+  //
+  // Create a page table that maps [0, 2M] with one 2M page.
+  //
+  PagingMode                  = Paging4Level;
+  PageTable                   = 0;
+  PageTableBufferSize         = 0;
+  MapAttribute.Uint64         = 0;
+  MapAttribute.Bits.Present   = 1;
+  MapAttribute.Bits.ReadWrite = 1;
+  MapMask.Uint64              = MAX_UINT64;
+  Status                      = PageTableMap (&PageTable, PagingMode, NULL, &PageTableBufferSize, 0, SIZE_2MB, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  UT_ASSERT_NOT_EQUAL (Buffer, NULL);
+  Status = PageTableMap (&PageTable, PagingMode, Buffer, &PageTableBufferSize, 0, SIZE_2MB, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  //
+  // Map [0, 2M] as read-only and then [0, 4K] as read-write.
+  // Neither range needs a new page on the input page table, but the second range splits
+  // the 2M page after the first range makes it read-only.
+  //
+  ZeroMem (Requests, sizeof (Requests));
+  Requests[0].LinearAddress       = 0;
+  Requests[0].Length              = SIZE_2MB;
+  Requests[0].Mask.Bits.ReadWrite = 1;
+
+  Requests[1].LinearAddress            = 0;
+  Requests[1].Length                   = SIZE_4KB;
+  Requests[1].Attribute.Bits.ReadWrite = 1;
+  Requests[1].Mask.Bits.ReadWrite      = 1;
+
+  PageTableBufferSize = 0;
+  Status              = PageTableMapRanges (&PageTable, PagingMode, NULL, &PageTableBufferSize, Requests, ARRAY_SIZE (Requests), &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (PageTableBufferSize, SIZE_4KB);
+
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  UT_ASSERT_NOT_EQUAL (Buffer, NULL);
+  Status = PageTableMapRanges (&PageTable, PagingMode, Buffer, &PageTableBufferSize, Requests, ARRAY_SIZE (Requests), &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (PageTableBufferSize, 0);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+
+  TestStatus = IsPageTableValid (PageTable, PagingMode);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  MapCount = ARRAY_SIZE (Map);
+  Status   = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 2);
+  UT_ASSERT_EQUAL (Map[0].LinearAddress, 0);
+  UT_ASSERT_EQUAL (Map[0].Length, SIZE_4KB);
+  UT_ASSERT_EQUAL (Map[0].Attribute.Bits.ReadWrite, 1);
+  UT_ASSERT_EQUAL (Map[1].LinearAddress, SIZE_4KB);
+  UT_ASSERT_EQUAL (Map[1].Length, SIZE_2MB - SIZE_4KB);
+  UT_ASSERT_EQUAL (Map[1].Attribute.Bits.ReadWrite, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
 /**
   Initialize the unit test framework, suite, and unit tests for the
   sample unit tests and run the unit tests.
@@ -872,6 +1164,8 @@ UefiTestMain (
   AddTestCase (ManualTestCase, "Check if the parent entry has different Nx attribute", "Manual Test Case6", TestCaseManualChangeNx, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check if the needed size is expected", "Manual Test Case7", TestCaseManualSizeNotMatch, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check MapMask when creating new page table or mapping not-present range", "Manual Test Case8", TestCaseToCheckMapMaskAndAttr, NULL, NULL, NULL);
+  AddTestCase (ManualTestCase, "Check PageTableMapRanges maps the same as PageTableMap per range", "Manual Test Case9", TestCaseMapRanges, NULL, NULL, NULL);
+  AddTestCase (ManualTestCase, "Check PageTableMapRanges with a range that splits a page changed by an earlier range", "Manual Test Case10", TestCaseMapOverlappingRanges, NULL, NULL, NULL);
   //
   // Populate the Random Test Cases.
   //
@@ -2285,19 +2285,25 @@ MpInitLibInitialize (
       //
       // Wakeup all APs and calculate the processor count in system
       //
+      PERF_INMODULE_BEGIN ("MpCollectProcessorCount");
       CollectProcessorCount (CpuMpData);
+      PERF_INMODULE_END ("MpCollectProcessorCount");
 
       //
       // Enable X2APIC if needed.
       //
       if (CpuMpData->InitialBspApicMode == LOCAL_APIC_MODE_XAPIC) {
+        PERF_INMODULE_BEGIN ("MpAutoEnableX2Apic");
         AutoEnableX2Apic (CpuMpData);
+        PERF_INMODULE_END ("MpAutoEnableX2Apic");
       }
 
       //
       // Sort BSP/Aps by CPU APIC ID in ascending order
       //
+      PERF_INMODULE_BEGIN ("MpSortApicId");
       SortApicId (CpuMpData);
+      PERF_INMODULE_END ("MpSortApicId");
 
       DEBUG ((DEBUG_INFO, "MpInitLib: Find %d processors in system.\n", CpuMpData->CpuCount));
     }
@@ -2416,6 +2422,7 @@ MpInitLibInitialize (
   // Wakeup APs to do some AP initialize sync (Microcode & MTRR)
   //
   if (CpuMpData->CpuCount > 1) {
+    PERF_INMODULE_BEGIN ("MpApInitializeSync");
     WakeUpAP (CpuMpData, TRUE, 0, ApInitializeSync, CpuMpData, TRUE);
     //
     // Wait for all APs finished initialization
@@ -2427,6 +2434,8 @@ MpInitLibInitialize (
     for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
       SetApState (&CpuMpData->CpuData[Index], CpuStateIdle);
     }
+
+    PERF_INMODULE_END ("MpApInitializeSync");
   }
 
   //
@@ -35,6 +35,7 @@
 #include <Library/MicrocodeLib.h>
 #include <Library/CpuPageTableLib.h>
 #include <Library/SafeIntLib.h>
+#include <Library/PerformanceLib.h>
 #include <ConfidentialComputingGuestAttr.h>
 
 #include <Register/Amd/SevSnpMsr.h>
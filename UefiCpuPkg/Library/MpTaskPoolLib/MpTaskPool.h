@@ -0,0 +1,93 @@
+/** @file
+  Internal header file for the MP Task Pool Library instances.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef MP_TASK_POOL_H_
+#define MP_TASK_POOL_H_
+
+#include <PiPei.h>
+#include <PiDxe.h>
+#include <Ppi/MpServices2.h>
+#include <Protocol/MpService.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/MpTaskPoolLib.h>
+
+typedef union {
+  EFI_MP_SERVICES_PROTOCOL    *Protocol;
+  EFI_PEI_MP_SERVICES2_PPI    *Ppi;
+} MP_SERVICES;
+
+/**
+  Worker function to locate the MP services.
+
+  @param[out] MpServices    The MP Services Protocol in DXE, or the MP Services2
+                            PPI in PEI.
+
+  @retval EFI_SUCCESS       The MP services are located.
+  @retval EFI_NOT_FOUND     The MP services are not installed.
+**/
+EFI_STATUS
+MpTaskPoolGetMpServices (
+  OUT MP_SERVICES  *MpServices
+  );
+
+/**
+  Worker function to retrieve the number of logical processors in the platform.
+
+  @param[in]  MpServices                  The MP services.
+  @param[out] NumberOfProcessors          The total number of logical processors,
+                                          including the BSP and disabled APs.
+  @param[out] NumberOfEnabledProcessors   The number of enabled logical processors,
+                                          including the BSP.
+
+  @return Status of GetNumberOfProcessors() of the MP services.
+**/
+EFI_STATUS
+MpTaskPoolGetNumberOfProcessors (
+  IN  MP_SERVICES  MpServices,
+  OUT UINTN        *NumberOfProcessors,
+  OUT UINTN        *NumberOfEnabledProcessors
+  );
+
+/**
+  Worker function to return the number of the calling processor.
+  It is called on the BSP and on the APs.
+
+  @param[in]  MpServices        The MP services.
+  @param[out] ProcessorNumber   The number of the calling processor.
+
+  @return Status of WhoAmI() of the MP services.
+**/
+EFI_STATUS
+MpTaskPoolWhoAmI (
+  IN  MP_SERVICES  MpServices,
+  OUT UINTN        *ProcessorNumber
+  );
+
+/**
+  Worker function to run a procedure on all enabled APs at the same time and
+  wait for them to finish.
+
+  @param[in] MpServices          The MP services.
+  @param[in] Procedure           The procedure to run on the APs.
+  @param[in] ProcedureArgument   The parameter passed to Procedure.
+
+  @return Status of StartupAllAPs() of the MP services.
+**/
+EFI_STATUS
+MpTaskPoolStartupAllAPs (
+  IN MP_SERVICES       MpServices,
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *ProcedureArgument
+  );
+
+#endif
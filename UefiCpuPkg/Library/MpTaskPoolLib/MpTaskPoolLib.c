@@ -0,0 +1,261 @@
+/** @file
+  MP Task Pool Library functions common to the PEI and DXE instances.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "MpTaskPool.h"
+
+//
+// Queues are padded to this size so that processors working on their own
+// queues do not contend for the same cache line. The queue array is allocated
+// in pages, so every queue starts at a multiple of this size.
+//
+#define MP_TASK_QUEUE_SIZE  64
+
+//
+// A queue owns the task indexes [Head, Tail). Both indexes are packed into one
+// 64-bit value, so that the owner taking tasks from the head and other
+// processors stealing tasks from the tail are serialized by a single
+// compare-exchange.
+//
+typedef struct {
+  volatile UINT64    Range;
+  UINT8              Reserved[MP_TASK_QUEUE_SIZE - sizeof (UINT64)];
+} MP_TASK_QUEUE;
+
+typedef struct {
+  MP_SERVICES                 MpServices;
+  MP_TASK                     *Tasks;
+  MP_TASK_QUEUE               *Queues;
+  UINTN                       QueueCount;
+} MP_TASK_POOL;
+
+#define MP_TASK_RANGE(Head, Tail)  (LShiftU64 ((UINT64)(Tail), 32) | (UINT32)(Head))
+
+/**
+  Take one task out of a queue.
+
+  @param[in]  Queue       The queue to take the task from.
+  @param[in]  FromTail    TRUE to take the task from the tail of the queue,
+                          FALSE to take it from the head.
+  @param[out] TaskIndex   The index of the task that was taken.
+
+  @retval TRUE    A task was taken.
+  @retval FALSE   The queue is empty.
+
+**/
+STATIC
+BOOLEAN
+TakeTask (
+  IN  MP_TASK_QUEUE  *Queue,
+  IN  BOOLEAN        FromTail,
+  OUT UINTN          *TaskIndex
+  )
+{
+  UINT64  Range;
+  UINT32  Head;
+  UINT32  Tail;
+
+  do {
+    Range = Queue->Range;
+    Head  = (UINT32)Range;
+    Tail  = (UINT32)RShiftU64 (Range, 32);
+    if (Head >= Tail) {
+      return FALSE;
+    }
+
+    if (FromTail) {
+      Tail--;
+      *TaskIndex = Tail;
+    } else {
+      *TaskIndex = Head;
+      Head++;
+    }
+  } while (InterlockedCompareExchange64 (&Queue->Range, Range, MP_TASK_RANGE (Head, Tail)) != Range);
+
+  return TRUE;
+}
+
+/**
+  Run tasks until all queues are empty.
+
+  The processor first drains its own queue from the head, then steals tasks
+  from the tail of the queues of the other processors. Queues never grow, so a
+  single pass over all queues is enough.
+
+  @param[in] Pool             The task pool.
+  @param[in] ProcessorNumber  The number of the calling processor.
+
+**/
+STATIC
+VOID
+RunTasks (
+  IN MP_TASK_POOL  *Pool,
+  IN UINTN         ProcessorNumber
+  )
+{
+  UINTN  Index;
+  UINTN  TaskIndex;
+
+  for (Index = 0; Index < Pool->QueueCount; Index++) {
+    while (TakeTask (&Pool->Queues[(ProcessorNumber + Index) % Pool->QueueCount], (BOOLEAN)(Index != 0), &TaskIndex)) {
+      Pool->Tasks[TaskIndex].Procedure (Pool->Tasks[TaskIndex].Context);
+    }
+  }
+}
+
+/**
+  Procedure run on every enabled AP by StartupAllAPs().
+
+  @param[in, out] Buffer   Pointer to the MP_TASK_POOL.
+
+**/
+STATIC
+VOID
+EFIAPI
+ApRunTasks (
+  IN OUT VOID  *Buffer
+  )
+{
+  MP_TASK_POOL  *Pool;
+  UINTN         ProcessorNumber;
+  EFI_STATUS    Status;
+
+  Pool   = (MP_TASK_POOL *)Buffer;
+  Status = MpTaskPoolWhoAmI (Pool->MpServices, &ProcessorNumber);
+  if (EFI_ERROR (Status)) {
+    ProcessorNumber = 0;
+  }
+
+  RunTasks (Pool, ProcessorNumber);
+}
+
+/**
+  Run a batch of independent tasks on all enabled application processors.
+
+  The tasks are divided into one queue per processor. Every AP first runs the
+  tasks in its own queue and then steals tasks from the queues of the other
+  processors, so that processors which finish early, or which are disabled,
+  do not hold back the batch. The function returns after all tasks have run.
+
+  Tasks must not depend on each other. The order in which tasks run is not
+  defined.
+
+  If the MP services are not available, or if StartupAllAPs() can not
+  dispatch the APs, the remaining tasks are run on the calling processor.
+  The per-processor queues are allocated in pages, so the PEI instance can only
+  be used after permanent memory is installed.
+
+  @param[in] Tasks          Array of tasks to run.
+  @param[in] TaskCount      Number of entries in Tasks.
+
+  @retval EFI_SUCCESS            All tasks have run.
+  @retval EFI_INVALID_PARAMETER  Tasks is NULL and TaskCount is not 0.
+  @retval EFI_INVALID_PARAMETER  TaskCount is larger than MAX_UINT32.
+  @retval EFI_INVALID_PARAMETER  A task has a NULL Procedure.
+  @retval EFI_OUT_OF_RESOURCES   There are not enough resources to set up the
+                                 per-processor queues. No task has run.
+
+**/
+EFI_STATUS
+EFIAPI
+MpTaskPoolRun (
+  IN MP_TASK  *Tasks,
+  IN UINTN    TaskCount
+  )
+{
+  EFI_STATUS    Status;
+  MP_SERVICES   MpServices;
+  MP_TASK_POOL  Pool;
+  UINTN         NumberOfProcessors;
+  UINTN         NumberOfEnabledProcessors;
+  UINTN         BspNumber;
+  UINTN         ApCount;
+  UINTN         ApIndex;
+  UINTN         Index;
+  UINTN         Start;
+  UINTN         End;
+  UINTN         QueuePages;
+
+  if (((Tasks == NULL) && (TaskCount != 0)) || (TaskCount > MAX_UINT32)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < TaskCount; Index++) {
+    if (Tasks[Index].Procedure == NULL) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  if (TaskCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  NumberOfProcessors = 1;
+  BspNumber          = 0;
+  Status             = MpTaskPoolGetMpServices (&MpServices);
+  if (!EFI_ERROR (Status)) {
+    Status = MpTaskPoolGetNumberOfProcessors (MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors);
+    if (!EFI_ERROR (Status) && (NumberOfEnabledProcessors > 1)) {
+      Status = MpTaskPoolWhoAmI (MpServices, &BspNumber);
+    } else if (!EFI_ERROR (Status)) {
+      Status = EFI_UNSUPPORTED;
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    MpServices.Protocol = NULL;
+    NumberOfProcessors  = 1;
+    BspNumber           = 0;
+  }
+
+  Pool.MpServices = MpServices;
+  Pool.Tasks      = Tasks;
+  Pool.QueueCount = NumberOfProcessors;
+  QueuePages      = EFI_SIZE_TO_PAGES (NumberOfProcessors * sizeof (MP_TASK_QUEUE));
+  Pool.Queues     = AllocatePages (QueuePages);
+  if (Pool.Queues == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ZeroMem (Pool.Queues, EFI_PAGES_TO_SIZE (QueuePages));
+
+  if (MpServices.Protocol == NULL) {
+    Pool.Queues[0].Range = MP_TASK_RANGE (0, TaskCount);
+  } else {
+    //
+    // Split the tasks evenly between the APs. The BSP only steals work when
+    // the APs could not be started.
+    //
+    ApCount = NumberOfProcessors - 1;
+    ApIndex = 0;
+    Start   = 0;
+    for (Index = 0; Index < NumberOfProcessors; Index++) {
+      if (Index == BspNumber) {
+        continue;
+      }
+
+      End                      = Start + (TaskCount - Start) / (ApCount - ApIndex);
+      Pool.Queues[Index].Range = MP_TASK_RANGE (Start, End);
+      Start                    = End;
+      ApIndex++;
+    }
+
+    Status = MpTaskPoolStartupAllAPs (MpServices, ApRunTasks, &Pool);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_WARN, "%a: StartupAllAPs() - %r, running tasks on BSP\n", __func__, Status));
+    }
+  }
+
+  //
+  // Run whatever the APs did not run. After StartupAllAPs() succeeds all
+  // queues are already empty.
+  //
+  RunTasks (&Pool, BspNumber);
+
+  FreePages (Pool.Queues, QueuePages);
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/** @file
+  MP Task Pool Library instance for PEI module.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+
+#include <Library/PeiServicesLib.h>
+
+#include "MpTaskPool.h"
+
+/**
+  Worker function to locate the MP services.
+
+  @param[out] MpServices    The MP Services Protocol in DXE, or the MP Services2
+                            PPI in PEI.
+
+  @retval EFI_SUCCESS       The MP services are located.
+  @retval EFI_NOT_FOUND     The MP services are not installed.
+**/
+EFI_STATUS
+MpTaskPoolGetMpServices (
+  OUT MP_SERVICES  *MpServices
+  )
+{
+  return PeiServicesLocatePpi (
+           &gEfiPeiMpServices2PpiGuid,
+           0,
+           NULL,
+           (VOID **)&MpServices->Ppi
+           );
+}
+
+/**
+  Worker function to retrieve the number of logical processors in the platform.
+
+  @param[in]  MpServices                  The MP services.
+  @param[out] NumberOfProcessors          The total number of logical processors,
+                                          including the BSP and disabled APs.
+  @param[out] NumberOfEnabledProcessors   The number of enabled logical processors,
+                                          including the BSP.
+
+  @return Status of GetNumberOfProcessors() of the MP services.
+**/
+EFI_STATUS
+MpTaskPoolGetNumberOfProcessors (
+  IN  MP_SERVICES  MpServices,
+  OUT UINTN        *NumberOfProcessors,
+  OUT UINTN        *NumberOfEnabledProcessors
+  )
+{
+  return MpServices.Ppi->GetNumberOfProcessors (
+                           MpServices.Ppi,
+                           NumberOfProcessors,
+                           NumberOfEnabledProcessors
+                           );
+}
+
+/**
+  Worker function to return the number of the calling processor.
+  It is called on the BSP and on the APs.
+
+  @param[in]  MpServices        The MP services.
+  @param[out] ProcessorNumber   The number of the calling processor.
+
+  @return Status of WhoAmI() of the MP services.
+**/
+EFI_STATUS
+MpTaskPoolWhoAmI (
+  IN  MP_SERVICES  MpServices,
+  OUT UINTN        *ProcessorNumber
+  )
+{
+  //
+  // The PPI is passed in directly, as an AP must not use the PEI Services Table.
+  //
+  return MpServices.Ppi->WhoAmI (MpServices.Ppi, ProcessorNumber);
+}
+
+/**
+  Worker function to run a procedure on all enabled APs at the same time and
+  wait for them to finish.
+
+  @param[in] MpServices          The MP services.
+  @param[in] Procedure           The procedure to run on the APs.
+  @param[in] ProcedureArgument   The parameter passed to Procedure.
+
+  @return Status of StartupAllAPs() of the MP services.
+**/
+EFI_STATUS
+MpTaskPoolStartupAllAPs (
+  IN MP_SERVICES       MpServices,
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *ProcedureArgument
+  )
+{
+  return MpServices.Ppi->StartupAllAPs (
+                           MpServices.Ppi,
+                           Procedure,
+                           FALSE,
+                           0,
+                           ProcedureArgument
+                           );
+}
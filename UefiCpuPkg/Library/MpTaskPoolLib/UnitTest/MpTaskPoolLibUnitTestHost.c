@@ -0,0 +1,482 @@
+/** @file
+  Unit tests of the DxeMpTaskPoolLib instance of the MpTaskPoolLib class.
+
+  The tests install a fake MP Services Protocol which runs the AP procedure on
+  each enabled AP one after the other.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <PiDxe.h>
+#include <Protocol/MpService.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/UnitTestLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/MpTaskPoolLib.h>
+
+#define UNIT_TEST_APP_NAME     "MP Task Pool Lib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define FAKE_MAX_PROCESSORS  8
+#define FAKE_BSP_NUMBER      2
+#define TEST_MAX_TASKS       100
+
+typedef struct {
+  UINTN         NumberOfProcessors;
+  BOOLEAN       Enabled[FAKE_MAX_PROCESSORS];
+  EFI_STATUS    StartupStatus;
+  BOOLEAN       InstallMpServices;
+  UINTN         TaskCount;
+} MP_TASK_POOL_TEST_CONTEXT;
+
+typedef struct {
+  UINTN    RunCount;
+  UINTN    ProcessorNumber;
+} TEST_TASK_RESULT;
+
+STATIC MP_TASK_POOL_TEST_CONTEXT  *mContext;
+STATIC UINTN                      mCurrentProcessor;
+STATIC EFI_HANDLE                 mMpServicesHandle;
+STATIC TEST_TASK_RESULT           mResults[TEST_MAX_TASKS];
+STATIC MP_TASK                    mTasks[TEST_MAX_TASKS];
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.GetNumberOfProcessors().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeGetNumberOfProcessors (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  OUT UINTN                     *NumberOfProcessors,
+  OUT UINTN                     *NumberOfEnabledProcessors
+  )
+{
+  UINTN  Index;
+
+  *NumberOfProcessors        = mContext->NumberOfProcessors;
+  *NumberOfEnabledProcessors = 0;
+  for (Index = 0; Index < mContext->NumberOfProcessors; Index++) {
+    if (mContext->Enabled[Index]) {
+      (*NumberOfEnabledProcessors)++;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.GetProcessorInfo().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeGetProcessorInfo (
+  IN  EFI_MP_SERVICES_PROTOCOL   *This,
+  IN  UINTN                      ProcessorNumber,
+  OUT EFI_PROCESSOR_INFORMATION  *ProcessorInfoBuffer
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.StartupAllAPs() which runs Procedure on each
+  enabled AP in turn.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeStartupAllAPs (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  EFI_AP_PROCEDURE          Procedure,
+  IN  BOOLEAN                   SingleThread,
+  IN  EFI_EVENT                 WaitEvent OPTIONAL,
+  IN  UINTN                     TimeoutInMicroSeconds,
+  IN  VOID                      *ProcedureArgument OPTIONAL,
+  OUT UINTN                     **FailedCpuList OPTIONAL
+  )
+{
+  UINTN  Index;
+
+  if (EFI_ERROR (mContext->StartupStatus)) {
+    return mContext->StartupStatus;
+  }
+
+  for (Index = 0; Index < mContext->NumberOfProcessors; Index++) {
+    if ((Index != FAKE_BSP_NUMBER) && mContext->Enabled[Index]) {
+      mCurrentProcessor = Index;
+      Procedure (ProcedureArgument);
+    }
+  }
+
+  mCurrentProcessor = FAKE_BSP_NUMBER;
+  return EFI_SUCCESS;
+}
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.StartupThisAP().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeStartupThisAP (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  EFI_AP_PROCEDURE          Procedure,
+  IN  UINTN                     ProcessorNumber,
+  IN  EFI_EVENT                 WaitEvent OPTIONAL,
+  IN  UINTN                     TimeoutInMicroseconds,
+  IN  VOID                      *ProcedureArgument OPTIONAL,
+  OUT BOOLEAN                   *Finished OPTIONAL
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.SwitchBSP().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeSwitchBSP (
+  IN EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  UINTN                    ProcessorNumber,
+  IN  BOOLEAN                  EnableOldBSP
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.EnableDisableAP().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeEnableDisableAP (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  UINTN                     ProcessorNumber,
+  IN  BOOLEAN                   EnableAP,
+  IN  UINT32                    *HealthFlag OPTIONAL
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Fake EFI_MP_SERVICES_PROTOCOL.WhoAmI().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FakeWhoAmI (
+  IN EFI_MP_SERVICES_PROTOCOL  *This,
+  OUT UINTN                    *ProcessorNumber
+  )
+{
+  *ProcessorNumber = mCurrentProcessor;
+  return EFI_SUCCESS;
+}
+
+STATIC EFI_MP_SERVICES_PROTOCOL  mFakeMpServices = {
+  FakeGetNumberOfProcessors,
+  FakeGetProcessorInfo,
+  FakeStartupAllAPs,
+  FakeStartupThisAP,
+  FakeSwitchBSP,
+  FakeEnableDisableAP,
+  FakeWhoAmI
+};
+
+/**
+  Task procedure which records how often and where it ran.
+
+  @param[in, out] Context   Pointer to the TEST_TASK_RESULT of the task.
+**/
+STATIC
+VOID
+EFIAPI
+RecordTask (
+  IN OUT VOID  *Context
+  )
+{
+  TEST_TASK_RESULT  *Result;
+
+  Result = (TEST_TASK_RESULT *)Context;
+  Result->RunCount++;
+  Result->ProcessorNumber = mCurrentProcessor;
+}
+
+/**
+  Install the fake MP Services Protocol and prepare the tasks.
+
+  @param[in]  Context   Pointer to the MP_TASK_POOL_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED               The test environment is ready.
+  @retval UNIT_TEST_ERROR_PREREQUISITE_NOT_MET  The protocol could not be installed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+SetupTaskPool (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  mContext          = (MP_TASK_POOL_TEST_CONTEXT *)Context;
+  mCurrentProcessor = FAKE_BSP_NUMBER;
+  ZeroMem (mResults, sizeof (mResults));
+  for (Index = 0; Index < TEST_MAX_TASKS; Index++) {
+    mTasks[Index].Procedure = RecordTask;
+    mTasks[Index].Context   = &mResults[Index];
+  }
+
+  mMpServicesHandle = NULL;
+  if (mContext->InstallMpServices) {
+    Status = gBS->InstallProtocolInterface (
+                    &mMpServicesHandle,
+                    &gEfiMpServiceProtocolGuid,
+                    EFI_NATIVE_INTERFACE,
+                    &mFakeMpServices
+                    );
+    if (EFI_ERROR (Status)) {
+      return UNIT_TEST_ERROR_PREREQUISITE_NOT_MET;
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Uninstall the fake MP Services Protocol.
+
+  @param[in]  Context   Pointer to the MP_TASK_POOL_TEST_CONTEXT.
+**/
+STATIC
+VOID
+EFIAPI
+CleanupTaskPool (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  if (mMpServicesHandle != NULL) {
+    gBS->UninstallProtocolInterface (
+           mMpServicesHandle,
+           &gEfiMpServiceProtocolGuid,
+           &mFakeMpServices
+           );
+    mMpServicesHandle = NULL;
+  }
+}
+
+/**
+  Check that every task runs exactly once, and that the tasks run on the
+  expected processors.
+
+  @param[in]  Context   Pointer to the MP_TASK_POOL_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED               The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED    The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestEveryTaskRunsOnce (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN    Index;
+  BOOLEAN  ApsAvailable;
+
+  ApsAvailable = mContext->InstallMpServices && !EFI_ERROR (mContext->StartupStatus);
+  for (Index = 0; Index < mContext->NumberOfProcessors; Index++) {
+    if ((Index != FAKE_BSP_NUMBER) && mContext->Enabled[Index]) {
+      break;
+    }
+  }
+
+  ApsAvailable = ApsAvailable && (Index < mContext->NumberOfProcessors);
+
+  UT_ASSERT_NOT_EFI_ERROR (MpTaskPoolRun (mTasks, mContext->TaskCount));
+
+  for (Index = 0; Index < mContext->TaskCount; Index++) {
+    UT_ASSERT_EQUAL (mResults[Index].RunCount, 1);
+    if (ApsAvailable) {
+      UT_ASSERT_NOT_EQUAL (mResults[Index].ProcessorNumber, FAKE_BSP_NUMBER);
+      UT_ASSERT_TRUE (mContext->Enabled[mResults[Index].ProcessorNumber]);
+    } else {
+      UT_ASSERT_EQUAL (mResults[Index].ProcessorNumber, FAKE_BSP_NUMBER);
+    }
+  }
+
+  for ( ; Index < TEST_MAX_TASKS; Index++) {
+    UT_ASSERT_EQUAL (mResults[Index].RunCount, 0);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check the parameter validation of MpTaskPoolRun().
+
+  @param[in]  Context   Pointer to the MP_TASK_POOL_TEST_CONTEXT.
+
+  @retval UNIT_TEST_PASSED               The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED    The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+TestInvalidParameters (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UT_ASSERT_STATUS_EQUAL (MpTaskPoolRun (NULL, 1), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (MpTaskPoolRun (NULL, 0), EFI_SUCCESS);
+
+  mTasks[1].Procedure = NULL;
+  UT_ASSERT_STATUS_EQUAL (MpTaskPoolRun (mTasks, 2), EFI_INVALID_PARAMETER);
+  UT_ASSERT_EQUAL (mResults[0].RunCount, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+//
+// All processors enabled.
+//
+STATIC MP_TASK_POOL_TEST_CONTEXT  mAllEnabled = {
+  FAKE_MAX_PROCESSORS, { TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE }, EFI_SUCCESS, TRUE, TEST_MAX_TASKS
+};
+
+//
+// Some APs are disabled, their queues must be stolen by the other APs.
+//
+STATIC MP_TASK_POOL_TEST_CONTEXT  mSomeDisabled = {
+  FAKE_MAX_PROCESSORS, { TRUE, FALSE, TRUE, TRUE, FALSE, TRUE, TRUE, FALSE }, EFI_SUCCESS, TRUE, TEST_MAX_TASKS
+};
+
+//
+// Fewer tasks than processors.
+//
+STATIC MP_TASK_POOL_TEST_CONTEXT  mFewTasks = {
+  FAKE_MAX_PROCESSORS, { TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE }, EFI_SUCCESS, TRUE, 3
+};
+
+//
+// Only the BSP is enabled.
+//
+STATIC MP_TASK_POOL_TEST_CONTEXT  mBspOnly = {
+  FAKE_MAX_PROCESSORS, { FALSE, FALSE, TRUE, FALSE, FALSE, FALSE, FALSE, FALSE }, EFI_SUCCESS, TRUE, TEST_MAX_TASKS
+};
+
+//
+// The APs can not be started.
+//
+STATIC MP_TASK_POOL_TEST_CONTEXT  mStartupFails = {
+  FAKE_MAX_PROCESSORS, { TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE }, EFI_NOT_READY, TRUE, TEST_MAX_TASKS
+};
+
+//
+// The MP Services Protocol is not installed.
+//
+STATIC MP_TASK_POOL_TEST_CONTEXT  mNoMpServices = {
+  FAKE_MAX_PROCESSORS, { TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE }, EFI_SUCCESS, FALSE, TEST_MAX_TASKS
+};
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  MpTaskPoolLib and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      TaskPoolTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Populate the MpTaskPoolLib Unit Test Suite.
+  //
+  Status = CreateUnitTestSuite (&TaskPoolTests, Framework, "MpTaskPoolLib Tests", "MpTaskPoolLib.MpTaskPoolRun", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for MpTaskPoolLib Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite-----------Description--------------Name----------Function--------Pre---Post-------------------Context-----------
+  //
+  AddTestCase (TaskPoolTests, "Invalid parameters are rejected", "InvalidParameters", TestInvalidParameters, SetupTaskPool, CleanupTaskPool, &mAllEnabled);
+  AddTestCase (TaskPoolTests, "All processors enabled", "AllEnabled", TestEveryTaskRunsOnce, SetupTaskPool, CleanupTaskPool, &mAllEnabled);
+  AddTestCase (TaskPoolTests, "Some APs disabled", "SomeDisabled", TestEveryTaskRunsOnce, SetupTaskPool, CleanupTaskPool, &mSomeDisabled);
+  AddTestCase (TaskPoolTests, "Fewer tasks than processors", "FewTasks", TestEveryTaskRunsOnce, SetupTaskPool, CleanupTaskPool, &mFewTasks);
+  AddTestCase (TaskPoolTests, "Only the BSP is enabled", "BspOnly", TestEveryTaskRunsOnce, SetupTaskPool, CleanupTaskPool, &mBspOnly);
+  AddTestCase (TaskPoolTests, "StartupAllAPs fails", "StartupFails", TestEveryTaskRunsOnce, SetupTaskPool, CleanupTaskPool, &mStartupFails);
+  AddTestCase (TaskPoolTests, "No MP Services Protocol", "NoMpServices", TestEveryTaskRunsOnce, SetupTaskPool, CleanupTaskPool, &mNoMpServices);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param Argc  Number of arguments.
+  @param Argv  Array of arguments.
+
+  @return Test application exit code.
+**/
+INT32
+main (
+  INT32  Argc,
+  CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
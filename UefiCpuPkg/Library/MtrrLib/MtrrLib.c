@@ -20,6 +20,8 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 
+#include "MtrrLibCalculationCache.h"
+
 #define OR_SEED              0x0101010101010101ull
 #define CLEAR_SEED           0xFFFFFFFFFFFFFFFFull
 #define MAX_WEIGHT           MAX_UINT8
@@ -2370,6 +2372,9 @@ MtrrSetMemoryAttributesInMtrrSettings (
   MTRR_CONTEXT  MtrrContext;
   BOOLEAN       MtrrContextValid;
 
+  UINT64                A0;
+  MTRR_LIB_CALCULATION  *Calculation;
+
   Status = RETURN_SUCCESS;
   MtrrLibInitializeMtrrMask (&MtrrValidBitsMask, &MtrrValidAddressMask);
 
@@ -2539,20 +2544,39 @@ MtrrSetMemoryAttributesInMtrrSettings (
       //
       // 2.4. Calculate the Variable MTRR settings based on the Ranges.
       //      Buffer Too Small may be returned if the scratch buffer size is insufficient.
+      //      Reuse the settings when the same Ranges were calculated before.
       //
-      Status = MtrrLibSetMemoryRanges (
-                 DefaultType,
-                 LShiftU64 (1, (UINTN)HighBitSet64 (MtrrValidBitsMask)),
-                 WorkingRanges,
-                 WorkingRangeCount,
-                 Scratch,
-                 ScratchSize,
-                 WorkingVariableMtrr,
-                 FirmwareVariableMtrrCount + 1,
-                 &WorkingVariableMtrrCount
-                 );
-      if (RETURN_ERROR (Status)) {
-        goto Exit;
+      A0          = LShiftU64 (1, (UINTN)HighBitSet64 (MtrrValidBitsMask));
+      Calculation = MtrrLibGetCalculation (DefaultType, A0, WorkingRanges, WorkingRangeCount);
+
+      if ((Calculation != NULL) && Calculation->Valid) {
+        DEBUG ((DEBUG_CACHE, "  Reuse the calculated variable MTRRs, hash = %08x\n", Calculation->Hash));
+        if (Calculation->MtrrCount > FirmwareVariableMtrrCount + 1) {
+          Status = RETURN_OUT_OF_RESOURCES;
+          goto Exit;
+        }
+
+        WorkingVariableMtrrCount = Calculation->MtrrCount;
+        CopyMem (WorkingVariableMtrr, Calculation->Mtrrs, WorkingVariableMtrrCount * sizeof (WorkingVariableMtrr[0]));
+      } else {
+        Status = MtrrLibSetMemoryRanges (
+                   DefaultType,
+                   A0,
+                   WorkingRanges,
+                   WorkingRangeCount,
+                   Scratch,
+                   ScratchSize,
+                   WorkingVariableMtrr,
+                   FirmwareVariableMtrrCount + 1,
+                   &WorkingVariableMtrrCount
+                   );
+        if (RETURN_ERROR (Status)) {
+          goto Exit;
+        }
+
+        if (Calculation != NULL) {
+          MtrrLibSaveCalculation (Calculation, WorkingVariableMtrr, WorkingVariableMtrrCount);
+        }
       }
 
       //
@@ -0,0 +1,236 @@
+/** @file
+  Cache of the variable MTRR settings calculated by MtrrLib, for DXE and SMM
+  modules whose global variables are writable.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/MtrrLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+
+#include "MtrrLibCalculationCache.h"
+
+#define CALCULATION_CACHE_SIZE  4
+
+//
+// Results of the latest variable MTRR calculations.
+// Only used when PcdCpuMtrrCalculationCacheEnable is TRUE.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED STATIC MTRR_LIB_CALCULATION  mMtrrLibCalculationCache[CALCULATION_CACHE_SIZE];
+GLOBAL_REMOVE_IF_UNREFERENCED STATIC UINTN                 mMtrrLibCalculationCacheNext = 0;
+
+//
+// The calculation in progress. It only replaces a cache entry once it succeeds.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED STATIC MTRR_LIB_CALCULATION  mMtrrLibPendingCalculation;
+
+/**
+  Return the hash of the memory range array used to calculate the variable MTRR settings.
+
+  @param DefaultType  Default memory type.
+  @param A0           Alignment to use when base address is 0.
+  @param Ranges       Memory range array holding the memory type
+                      settings for all memory address.
+  @param RangeCount   Count of memory ranges.
+
+  @return The hash value.
+**/
+STATIC
+UINT32
+MtrrLibHashMemoryRanges (
+  IN MTRR_MEMORY_CACHE_TYPE   DefaultType,
+  IN UINT64                   A0,
+  IN CONST MTRR_MEMORY_RANGE  *Ranges,
+  IN UINTN                    RangeCount
+  )
+{
+  UINT32  Hash;
+  UINTN   Index;
+
+  //
+  // FNV-1a hash of the fields. The range type is folded into the low bits of
+  // the length which are always 0 because all ranges are 4KB aligned.
+  //
+  Hash = 0x811C9DC5;
+  Hash = (Hash ^ (UINT32)DefaultType) * 0x01000193;
+  Hash = (Hash ^ (UINT32)HighBitSet64 (A0)) * 0x01000193;
+  for (Index = 0; Index < RangeCount; Index++) {
+    Hash = (Hash ^ (UINT32)Ranges[Index].BaseAddress) * 0x01000193;
+    Hash = (Hash ^ (UINT32)RShiftU64 (Ranges[Index].BaseAddress, 32)) * 0x01000193;
+    Hash = (Hash ^ ((UINT32)Ranges[Index].Length | (UINT32)Ranges[Index].Type)) * 0x01000193;
+    Hash = (Hash ^ (UINT32)RShiftU64 (Ranges[Index].Length, 32)) * 0x01000193;
+  }
+
+  return Hash;
+}
+
+/**
+  Find the cached variable MTRR settings calculated for the memory range array.
+
+  @param DefaultType  Default memory type.
+  @param A0           Alignment to use when base address is 0.
+  @param Ranges       Memory range array holding the memory type
+                      settings for all memory address.
+  @param RangeCount   Count of memory ranges.
+  @param Hash         Hash of the memory range array returned by MtrrLibHashMemoryRanges().
+
+  @return The cached calculation or NULL if the memory range array is not calculated before.
+**/
+STATIC
+MTRR_LIB_CALCULATION *
+MtrrLibFindCalculation (
+  IN MTRR_MEMORY_CACHE_TYPE   DefaultType,
+  IN UINT64                   A0,
+  IN CONST MTRR_MEMORY_RANGE  *Ranges,
+  IN UINTN                    RangeCount,
+  IN UINT32                   Hash
+  )
+{
+  MTRR_LIB_CALCULATION  *Calculation;
+  UINTN                 Index;
+  UINTN                 RangeIndex;
+
+  for (Index = 0; Index < ARRAY_SIZE (mMtrrLibCalculationCache); Index++) {
+    Calculation = &mMtrrLibCalculationCache[Index];
+    if (!Calculation->Valid || (Calculation->Hash != Hash) || (Calculation->DefaultType != DefaultType) ||
+        (Calculation->A0 != A0) || (Calculation->RangeCount != RangeCount))
+    {
+      continue;
+    }
+
+    //
+    // Compare the ranges one by one because different range arrays may have the same hash.
+    //
+    for (RangeIndex = 0; RangeIndex < RangeCount; RangeIndex++) {
+      if ((Calculation->Ranges[RangeIndex].BaseAddress != Ranges[RangeIndex].BaseAddress) ||
+          (Calculation->Ranges[RangeIndex].Length != Ranges[RangeIndex].Length) ||
+          (Calculation->Ranges[RangeIndex].Type != Ranges[RangeIndex].Type))
+      {
+        break;
+      }
+    }
+
+    if (RangeIndex == RangeCount) {
+      return Calculation;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Reserve an entry for the variable MTRR settings to be calculated for the memory range array.
+
+  The memory range array is saved in the entry because MtrrLibSetMemoryRanges() modifies it.
+  The entry is outside of the cache until MtrrLibSaveCalculation() adds it, so a failed
+  calculation releases it by not saving it, and never evicts a cached calculation.
+
+  @param DefaultType  Default memory type.
+  @param A0           Alignment to use when base address is 0.
+  @param Ranges       Memory range array holding the memory type
+                      settings for all memory address.
+  @param RangeCount   Count of memory ranges.
+  @param Hash         Hash of the memory range array returned by MtrrLibHashMemoryRanges().
+
+  @return The reserved entry.
+**/
+STATIC
+MTRR_LIB_CALCULATION *
+MtrrLibReserveCalculation (
+  IN MTRR_MEMORY_CACHE_TYPE   DefaultType,
+  IN UINT64                   A0,
+  IN CONST MTRR_MEMORY_RANGE  *Ranges,
+  IN UINTN                    RangeCount,
+  IN UINT32                   Hash
+  )
+{
+  MTRR_LIB_CALCULATION  *Calculation;
+
+  ASSERT (RangeCount <= ARRAY_SIZE (Calculation->Ranges));
+
+  Calculation              = &mMtrrLibPendingCalculation;
+  Calculation->Valid       = FALSE;
+  Calculation->Hash        = Hash;
+  Calculation->DefaultType = DefaultType;
+  Calculation->A0          = A0;
+  Calculation->RangeCount  = RangeCount;
+  CopyMem (Calculation->Ranges, Ranges, RangeCount * sizeof (Ranges[0]));
+  return Calculation;
+}
+
+/**
+  Get the entry of the calculation cache for the memory range array.
+
+  If the variable MTRR settings for the memory range array were calculated
+  before, the returned entry is valid and holds them. Otherwise the returned
+  entry is reserved for the calculation, and MtrrLibSaveCalculation() adds it
+  to the cache once the calculation succeeds.
+
+  @param DefaultType  Default memory type.
+  @param A0           Alignment to use when base address is 0.
+  @param Ranges       Memory range array holding the memory type
+                      settings for all memory address.
+  @param RangeCount   Count of memory ranges.
+
+  @return The cached or reserved entry, or NULL if the cache is disabled.
+**/
+MTRR_LIB_CALCULATION *
+MtrrLibGetCalculation (
+  IN MTRR_MEMORY_CACHE_TYPE   DefaultType,
+  IN UINT64                   A0,
+  IN CONST MTRR_MEMORY_RANGE  *Ranges,
+  IN UINTN                    RangeCount
+  )
+{
+  UINT32                Hash;
+  MTRR_LIB_CALCULATION  *Calculation;
+
+  if (!FeaturePcdGet (PcdCpuMtrrCalculationCacheEnable)) {
+    return NULL;
+  }
+
+  Hash        = MtrrLibHashMemoryRanges (DefaultType, A0, Ranges, RangeCount);
+  Calculation = MtrrLibFindCalculation (DefaultType, A0, Ranges, RangeCount, Hash);
+  if (Calculation == NULL) {
+    Calculation = MtrrLibReserveCalculation (DefaultType, A0, Ranges, RangeCount, Hash);
+  }
+
+  return Calculation;
+}
+
+/**
+  Save the variable MTRR settings calculated for a reserved entry in the cache.
+
+  @param Calculation  The entry returned by MtrrLibGetCalculation().
+  @param Mtrrs        The calculated variable MTRR settings.
+  @param MtrrCount    Count of the calculated variable MTRR settings.
+**/
+VOID
+MtrrLibSaveCalculation (
+  IN MTRR_LIB_CALCULATION     *Calculation,
+  IN CONST MTRR_MEMORY_RANGE  *Mtrrs,
+  IN UINT32                   MtrrCount
+  )
+{
+  MTRR_LIB_CALCULATION  *Entry;
+
+  ASSERT (Calculation == &mMtrrLibPendingCalculation);
+  ASSERT (MtrrCount <= ARRAY_SIZE (Calculation->Mtrrs));
+
+  Calculation->MtrrCount = MtrrCount;
+  CopyMem (Calculation->Mtrrs, Mtrrs, MtrrCount * sizeof (Mtrrs[0]));
+  Calculation->Valid = TRUE;
+
+  //
+  // Replace the oldest entry.
+  //
+  Entry                        = &mMtrrLibCalculationCache[mMtrrLibCalculationCacheNext];
+  mMtrrLibCalculationCacheNext = (mMtrrLibCalculationCacheNext + 1) % ARRAY_SIZE (mMtrrLibCalculationCache);
+  CopyMem (Entry, Calculation, sizeof (*Entry));
+  Calculation->Valid = FALSE;
+}
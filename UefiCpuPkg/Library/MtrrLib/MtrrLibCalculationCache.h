@@ -0,0 +1,69 @@
+/** @file
+  Cache of the variable MTRR settings calculated by MtrrLib.
+
+  The cache is kept in global variables, so only the DXE and SMM instance
+  (DxeMtrrLib.inf) implements it. MtrrLib.inf is also linked into PEIMs that
+  execute in place and can not write their global variables, so it uses the
+  NULL implementation.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef MTRR_LIB_CALCULATION_CACHE_H_
+#define MTRR_LIB_CALCULATION_CACHE_H_
+
+//
+// Variable MTRR settings calculated for a memory range array.
+//
+typedef struct {
+  BOOLEAN                   Valid;
+  UINT32                    Hash;
+  MTRR_MEMORY_CACHE_TYPE    DefaultType;
+  UINT64                    A0;
+  UINTN                     RangeCount;
+  MTRR_MEMORY_RANGE         Ranges[2 * MTRR_NUMBER_OF_VARIABLE_MTRR + 2];
+  UINT32                    MtrrCount;
+  MTRR_MEMORY_RANGE         Mtrrs[MTRR_NUMBER_OF_VARIABLE_MTRR];
+} MTRR_LIB_CALCULATION;
+
+/**
+  Get the entry of the calculation cache for the memory range array.
+
+  If the variable MTRR settings for the memory range array were calculated
+  before, the returned entry is valid and holds them. Otherwise the returned
+  entry is reserved for the calculation, and MtrrLibSaveCalculation() adds it
+  to the cache once the calculation succeeds.
+
+  @param DefaultType  Default memory type.
+  @param A0           Alignment to use when base address is 0.
+  @param Ranges       Memory range array holding the memory type
+                      settings for all memory address.
+  @param RangeCount   Count of memory ranges.
+
+  @return The cached or reserved entry, or NULL if the cache is disabled.
+**/
+MTRR_LIB_CALCULATION *
+MtrrLibGetCalculation (
+  IN MTRR_MEMORY_CACHE_TYPE   DefaultType,
+  IN UINT64                   A0,
+  IN CONST MTRR_MEMORY_RANGE  *Ranges,
+  IN UINTN                    RangeCount
+  );
+
+/**
+  Save the variable MTRR settings calculated for a reserved entry in the cache.
+
+  @param Calculation  The entry returned by MtrrLibGetCalculation().
+  @param Mtrrs        The calculated variable MTRR settings.
+  @param MtrrCount    Count of the calculated variable MTRR settings.
+**/
+VOID
+MtrrLibSaveCalculation (
+  IN MTRR_LIB_CALCULATION     *Calculation,
+  IN CONST MTRR_MEMORY_RANGE  *Mtrrs,
+  IN UINT32                   MtrrCount
+  );
+
+#endif
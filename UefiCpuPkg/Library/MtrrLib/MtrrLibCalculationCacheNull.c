@@ -0,0 +1,55 @@
+/** @file
+  NULL implementation of the cache of calculated variable MTRR settings, for
+  modules that may not write their global variables.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/MtrrLib.h>
+#include <Library/DebugLib.h>
+
+#include "MtrrLibCalculationCache.h"
+
+/**
+  Get the entry of the calculation cache for the memory range array.
+
+  @param DefaultType  Default memory type.
+  @param A0           Alignment to use when base address is 0.
+  @param Ranges       Memory range array holding the memory type
+                      settings for all memory address.
+  @param RangeCount   Count of memory ranges.
+
+  @return NULL because the cache is not supported.
+**/
+MTRR_LIB_CALCULATION *
+MtrrLibGetCalculation (
+  IN MTRR_MEMORY_CACHE_TYPE   DefaultType,
+  IN UINT64                   A0,
+  IN CONST MTRR_MEMORY_RANGE  *Ranges,
+  IN UINTN                    RangeCount
+  )
+{
+  return NULL;
+}
+
+/**
+  Save the variable MTRR settings calculated for a reserved entry in the cache.
+
+  It is never called because MtrrLibGetCalculation() never reserves an entry.
+
+  @param Calculation  The entry returned by MtrrLibGetCalculation().
+  @param Mtrrs        The calculated variable MTRR settings.
+  @param MtrrCount    Count of the calculated variable MTRR settings.
+**/
+VOID
+MtrrLibSaveCalculation (
+  IN MTRR_LIB_CALCULATION     *Calculation,
+  IN CONST MTRR_MEMORY_RANGE  *Mtrrs,
+  IN UINT32                   MtrrCount
+  )
+{
+  ASSERT (FALSE);
+}
@@ -321,6 +321,180 @@ UnitTestMtrrSetAndGetMemoryAttributesInMtrrSettings (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Unit test of the variable MTRR calculation cache used by MtrrSetMemoryAttributesInMtrrSettings().
+
+  Setting the same memory layout again should reuse the calculated variable MTRR settings,
+  so it should not need any scratch buffer and should produce the same MTRR settings.
+
+  @param[in]  Context    Pointer to MTRR_LIB_SYSTEM_PARAMETER.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+  @retval  UNIT_TEST_SKIPPED            The calculation cache is disabled.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestMtrrSetMemoryAttributesInMtrrSettingsWithCalculationCache (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CONST MTRR_LIB_SYSTEM_PARAMETER  *SystemParameter;
+  RETURN_STATUS                    Status;
+  UINT32                           UcCount;
+  UINT32                           WtCount;
+  UINT32                           WbCount;
+  UINT32                           WpCount;
+  UINT32                           WcCount;
+
+  UINT8          *Scratch;
+  UINTN          ScratchSize;
+  MTRR_SETTINGS  LocalMtrrs;
+  MTRR_SETTINGS  CachedMtrrs;
+
+  MTRR_MEMORY_RANGE  RawMtrrRange[MTRR_NUMBER_OF_VARIABLE_MTRR];
+  MTRR_MEMORY_RANGE  ExpectedMemoryRanges[MTRR_NUMBER_OF_FIXED_MTRR * sizeof (UINT64) + 2 * MTRR_NUMBER_OF_VARIABLE_MTRR + 1];
+  UINTN              ExpectedMemoryRangesCount;
+
+  if (!FeaturePcdGet (PcdCpuMtrrCalculationCacheEnable)) {
+    return UNIT_TEST_SKIPPED;
+  }
+
+  SystemParameter = (MTRR_LIB_SYSTEM_PARAMETER *)Context;
+  GenerateRandomMemoryTypeCombination (
+    SystemParameter->VariableMtrrCount - PatchPcdGet32 (PcdCpuNumberOfReservedVariableMtrrs),
+    &UcCount,
+    &WtCount,
+    &WbCount,
+    &WpCount,
+    &WcCount
+    );
+  GenerateValidAndConfigurableMtrrPairs (
+    SystemParameter->PhysicalAddressBits - SystemParameter->MkTmeKeyidBits,
+    RawMtrrRange,
+    UcCount,
+    WtCount,
+    WbCount,
+    WpCount,
+    WcCount
+    );
+
+  ExpectedMemoryRangesCount = ARRAY_SIZE (ExpectedMemoryRanges);
+  GetEffectiveMemoryRanges (
+    SystemParameter->DefaultCacheType,
+    SystemParameter->PhysicalAddressBits - SystemParameter->MkTmeKeyidBits,
+    RawMtrrRange,
+    UcCount + WtCount + WbCount + WpCount + WcCount,
+    ExpectedMemoryRanges,
+    &ExpectedMemoryRangesCount
+    );
+
+  //
+  // The first call calculates the variable MTRR settings.
+  //
+  ZeroMem (&LocalMtrrs, sizeof (LocalMtrrs));
+  LocalMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+  ScratchSize            = SCRATCH_BUFFER_SIZE;
+  Scratch                = calloc (ScratchSize, sizeof (UINT8));
+  Status                 = MtrrSetMemoryAttributesInMtrrSettings (&LocalMtrrs, Scratch, &ScratchSize, ExpectedMemoryRanges, ExpectedMemoryRangesCount);
+  if (Status == RETURN_BUFFER_TOO_SMALL) {
+    Scratch = realloc (Scratch, ScratchSize);
+    Status  = MtrrSetMemoryAttributesInMtrrSettings (&LocalMtrrs, Scratch, &ScratchSize, ExpectedMemoryRanges, ExpectedMemoryRangesCount);
+  }
+
+  free (Scratch);
+  UT_ASSERT_STATUS_EQUAL (Status, RETURN_SUCCESS);
+
+  //
+  // The second call reuses the calculated settings without any scratch buffer.
+  //
+  ZeroMem (&CachedMtrrs, sizeof (CachedMtrrs));
+  CachedMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+  ScratchSize             = 0;
+  Status                  = MtrrSetMemoryAttributesInMtrrSettings (&CachedMtrrs, NULL, &ScratchSize, ExpectedMemoryRanges, ExpectedMemoryRangesCount);
+  UT_ASSERT_STATUS_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_MEM_EQUAL (&CachedMtrrs, &LocalMtrrs, sizeof (LocalMtrrs));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Unit test of the variable MTRR calculation cache when calculations fail.
+
+  Calculations that fail because there is no scratch buffer should not evict the
+  calculated settings of another memory layout from the cache.
+
+  @param[in]  Context    Pointer to MTRR_LIB_SYSTEM_PARAMETER.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+  @retval  UNIT_TEST_SKIPPED            The calculation cache is disabled.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestMtrrSetMemoryAttributesInMtrrSettingsWithFailedCalculations (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  RETURN_STATUS      Status;
+  UINT8              *Scratch;
+  UINTN              ScratchSize;
+  UINT32             Index;
+  MTRR_SETTINGS      LocalMtrrs;
+  MTRR_SETTINGS      CachedMtrrs;
+  MTRR_SETTINGS      FailedMtrrs;
+  MTRR_MEMORY_RANGE  Range;
+
+  if (!FeaturePcdGet (PcdCpuMtrrCalculationCacheEnable)) {
+    return UNIT_TEST_SKIPPED;
+  }
+
+  //
+  // A range of another type than the default type whose length is not a power
+  // of two can only be calculated with a scratch buffer.
+  //
+  Range.BaseAddress = SIZE_16MB;
+  Range.Length      = SIZE_16MB - SIZE_4KB;
+  Range.Type        = (MtrrGetDefaultMemoryType () == CacheUncacheable) ? CacheWriteBack : CacheUncacheable;
+
+  ZeroMem (&LocalMtrrs, sizeof (LocalMtrrs));
+  LocalMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+  ScratchSize            = SCRATCH_BUFFER_SIZE;
+  Scratch                = calloc (ScratchSize, sizeof (UINT8));
+  Status                 = MtrrSetMemoryAttributesInMtrrSettings (&LocalMtrrs, Scratch, &ScratchSize, &Range, 1);
+  free (Scratch);
+  UT_ASSERT_STATUS_EQUAL (Status, RETURN_SUCCESS);
+
+  //
+  // Fail the calculation of more memory layouts than the cache can hold.
+  //
+  for (Index = 0; Index < 16; Index++) {
+    ZeroMem (&FailedMtrrs, sizeof (FailedMtrrs));
+    FailedMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+    Range.Length            = SIZE_8MB + (2 * Index + 1) * SIZE_4KB;
+    ScratchSize             = 0;
+    Status                  = MtrrSetMemoryAttributesInMtrrSettings (&FailedMtrrs, NULL, &ScratchSize, &Range, 1);
+    UT_ASSERT_STATUS_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  }
+
+  //
+  // The first memory layout is still cached and needs no scratch buffer.
+  //
+  ZeroMem (&CachedMtrrs, sizeof (CachedMtrrs));
+  CachedMtrrs.MtrrDefType = MtrrGetDefaultMemoryType ();
+  Range.Length            = SIZE_16MB - SIZE_4KB;
+  ScratchSize             = 0;
+  Status                  = MtrrSetMemoryAttributesInMtrrSettings (&CachedMtrrs, NULL, &ScratchSize, &Range, 1);
+  UT_ASSERT_STATUS_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_MEM_EQUAL (&CachedMtrrs, &LocalMtrrs, sizeof (LocalMtrrs));
+
+  return UNIT_TEST_PASSED;
+}
+
 /**
   Test routine to check whether invalid base/size can be rejected.
 
@@ -1271,6 +1445,8 @@ UnitTestingEntry (
       AddTestCase (MtrrApiTests, "Test InvalidMemoryLayouts", "InvalidMemoryLayouts", UnitTestInvalidMemoryLayouts, InitializeSystem, NULL, &mSystemParameters[SystemIndex]);
       AddTestCase (MtrrApiTests, "Test MtrrSetMemoryAttributeInMtrrSettings and MtrrGetMemoryAttributesInMtrrSettings", "MtrrSetMemoryAttributeInMtrrSettings and MtrrGetMemoryAttributesInMtrrSettings", UnitTestMtrrSetMemoryAttributeAndGetMemoryAttributesInMtrrSettings, InitializeSystem, NULL, &mSystemParameters[SystemIndex]);
       AddTestCase (MtrrApiTests, "Test MtrrSetMemoryAttributesInMtrrSettings and MtrrGetMemoryAttributesInMtrrSettings", "MtrrSetMemoryAttributesInMtrrSettings and MtrrGetMemoryAttributesInMtrrSetting", UnitTestMtrrSetAndGetMemoryAttributesInMtrrSettings, InitializeSystem, NULL, &mSystemParameters[SystemIndex]);
+      AddTestCase (MtrrApiTests, "Test MtrrSetMemoryAttributesInMtrrSettings with calculation cache", "MtrrSetMemoryAttributesInMtrrSettingsWithCalculationCache", UnitTestMtrrSetMemoryAttributesInMtrrSettingsWithCalculationCache, InitializeSystem, NULL, &mSystemParameters[SystemIndex]);
+      AddTestCase (MtrrApiTests, "Test MtrrSetMemoryAttributesInMtrrSettings with failed calculations", "MtrrSetMemoryAttributesInMtrrSettingsWithFailedCalculations", UnitTestMtrrSetMemoryAttributesInMtrrSettingsWithFailedCalculations, InitializeSystem, NULL, &mSystemParameters[SystemIndex]);
     }
   }
 
@@ -284,13 +284,16 @@ CpuInitDataInitialize (
     }
   }
 
-  CpuFeaturesData->CpuFlags.CoreSemaphoreCount = AllocateZeroPool (sizeof (UINT32) * CpuStatus->PackageCount * CpuStatus->MaxCoreCount * CpuStatus->MaxThreadCount);
+  //
+  // One arrival counter per core and per package. See ProgramProcessorRegister().
+  //
+  CpuFeaturesData->CpuFlags.CoreSemaphoreCount = AllocateZeroPool (sizeof (UINT32) * CpuStatus->PackageCount * CpuStatus->MaxCoreCount);
   if (CpuFeaturesData->CpuFlags.CoreSemaphoreCount == NULL) {
     ASSERT (CpuFeaturesData->CpuFlags.CoreSemaphoreCount != NULL);
     goto ExitOnError;
   }
 
-  CpuFeaturesData->CpuFlags.PackageSemaphoreCount = AllocateZeroPool (sizeof (UINT32) * CpuStatus->PackageCount * CpuStatus->MaxCoreCount * CpuStatus->MaxThreadCount);
+  CpuFeaturesData->CpuFlags.PackageSemaphoreCount = AllocateZeroPool (sizeof (UINT32) * CpuStatus->PackageCount);
   if (CpuFeaturesData->CpuFlags.PackageSemaphoreCount == NULL) {
     ASSERT (CpuFeaturesData->CpuFlags.PackageSemaphoreCount != NULL);
     goto ExitOnError;
@@ -898,44 +901,57 @@ AnalysisProcessorFeatures (
 }
 
 /**
-  Increment semaphore by 1.
+  Wait until all valid threads in the core or package arrive at the same semaphore entry.
+
+  Each thread increments the arrival counter once per semaphore entry, so the Nth
+  semaphore entry is passed when the counter reaches N times the valid thread count.
+  The counter is never decremented in between, so waiting threads only read it.
 
-  @param      Sem            IN:  32-bit unsigned integer
+  @param[in, out] Counter       Arrival counter of the core or package.
+  @param[in, out] Generation    Number of semaphore entries of the same type passed by this thread.
+  @param[in]      ThreadCount   Valid thread count in the core or package.
 
 **/
 VOID
-LibReleaseSemaphore (
-  IN OUT  volatile UINT32  *Sem
+LibWaitForAllThreads (
+  IN OUT volatile UINT32  *Counter,
+  IN OUT UINT32           *Generation,
+  IN     UINT32           ThreadCount
   )
 {
-  InterlockedIncrement (Sem);
+  UINT32  Target;
+
+  (*Generation)++;
+  Target = *Generation * ThreadCount;
+
+  InterlockedIncrement (Counter);
+  while (*Counter < Target) {
+    CpuPause ();
+  }
 }
 
 /**
-  Decrement the semaphore by 1 if it is not zero.
+  Reset the arrival counters used by the semaphore entries in register tables.
 
-  Performs an atomic decrement operation for semaphore.
-  The compare exchange operation must be performed using
-  MP safe mechanisms.
-
-  @param      Sem            IN:  32-bit unsigned integer
+  @param[in] CpuFeaturesData  Pointer to CPU_FEATURES_DATA.
 
+  @note This service could be called by BSP only, before any processor programs its register table.
 **/
 VOID
-LibWaitForSemaphore (
-  IN OUT  volatile UINT32  *Sem
+ResetProcessorRegisterSemaphores (
+  IN CPU_FEATURES_DATA  *CpuFeaturesData
   )
 {
-  UINT32  Value;
-
-  do {
-    Value = *Sem;
-  } while (Value == 0 ||
-           InterlockedCompareExchange32 (
-             Sem,
-             Value,
-             Value - 1
-             ) != Value);
+  CPU_STATUS_INFORMATION  *CpuStatus;
+
+  CpuStatus = &CpuFeaturesData->AcpiCpuData->CpuFeatureInitData.CpuStatus;
+  if (CpuFeaturesData->CpuFlags.CoreSemaphoreCount != NULL) {
+    ZeroMem ((VOID *)CpuFeaturesData->CpuFlags.CoreSemaphoreCount, sizeof (UINT32) * CpuStatus->PackageCount * CpuStatus->MaxCoreCount);
+  }
+
+  if (CpuFeaturesData->CpuFlags.PackageSemaphoreCount != NULL) {
+    ZeroMem ((VOID *)CpuFeaturesData->CpuFlags.PackageSemaphoreCount, sizeof (UINT32) * CpuStatus->PackageCount);
+  }
 }
 
 /**
@@ -1016,13 +1032,11 @@ ProgramProcessorRegister (
   UINTN                     Index;
   UINTN                     Value;
   CPU_REGISTER_TABLE_ENTRY  *RegisterTableEntryHead;
-  volatile UINT32           *SemaphorePtr;
-  UINT32                    FirstThread;
-  UINT32                    CurrentThread;
   UINT32                    CurrentCore;
-  UINTN                     ProcessorIndex;
   UINT32                    *ThreadCountPerPackage;
   UINT8                     *ThreadCountPerCore;
+  UINT32                    CoreGeneration;
+  UINT32                    PackageGeneration;
   EFI_STATUS                Status;
   UINT64                    CurrentValue;
 
@@ -1030,6 +1044,8 @@ ProgramProcessorRegister (
   // Traverse Register Table of this logical processor
   //
   RegisterTableEntryHead = (CPU_REGISTER_TABLE_ENTRY *)(UINTN)RegisterTable->RegisterTableEntry;
+  CoreGeneration         = 0;
+  PackageGeneration      = 0;
 
   for (Index = 0; Index < RegisterTable->TableLength; Index++) {
     RegisterTableEntry = &RegisterTableEntryHead[Index];
@@ -1141,96 +1157,39 @@ ProgramProcessorRegister (
       case Semaphore:
         // Semaphore works logic like below:
         //
-        //  V(x) = LibReleaseSemaphore (Semaphore[FirstThread + x]);
-        //  P(x) = LibWaitForSemaphore (Semaphore[FirstThread + x]);
+        //  A(x) = LibWaitForAllThreads (Counter, x, ThreadCount);
         //
-        //  All threads (T0...Tn) waits in P() line and continues running
+        //  Every valid thread in the core or package increments the shared
+        //  counter once and waits until the counter reaches x * ThreadCount
+        //  for the x-th semaphore entry of this type in its register table.
+        //  All threads (T0...Tn) waits in A() line and continues running
         //  together.
         //
-        //
         //  T0             T1            ...           Tn
         //
-        //  V(0...n)       V(0...n)      ...           V(0...n)
-        //  n * P(0)       n * P(1)      ...           n * P(n)
+        //  A(x)           A(x)          ...           A(x)
+        //
+        //  Each thread only does one atomic operation per semaphore entry,
+        //  instead of releasing the semaphore of every thread in the scope.
         //
         switch (RegisterTableEntry->Value) {
           case CoreDepType:
-            SemaphorePtr       = CpuFlags->CoreSemaphoreCount;
             ThreadCountPerCore = (UINT8 *)(UINTN)CpuStatus->ThreadCountPerCore;
-
-            CurrentCore = ApLocation->Package * CpuStatus->MaxCoreCount + ApLocation->Core;
-            //
-            // Get Offset info for the first thread in the core which current thread belongs to.
-            //
-            FirstThread   = CurrentCore * CpuStatus->MaxThreadCount;
-            CurrentThread = FirstThread + ApLocation->Thread;
-
-            //
-            // Different cores may have different valid threads in them. If driver maintail clearly
-            // thread index in different cores, the logic will be much complicated.
-            // Here driver just simply records the max thread number in all cores and use it as expect
-            // thread number for all cores.
-            // In below two steps logic, first current thread will Release semaphore for each thread
-            // in current core. Maybe some threads are not valid in this core, but driver don't
-            // care. Second, driver will let current thread wait semaphore for all valid threads in
-            // current core. Because only the valid threads will do release semaphore for this
-            // thread, driver here only need to wait the valid thread count.
-            //
-
-            //
-            // First Notify ALL THREADs in current Core that this thread is ready.
-            //
-            for (ProcessorIndex = 0; ProcessorIndex < CpuStatus->MaxThreadCount; ProcessorIndex++) {
-              LibReleaseSemaphore (&SemaphorePtr[FirstThread + ProcessorIndex]);
-            }
-
-            //
-            // Second, check whether all VALID THREADs (not all threads) in current core are ready.
-            //
-            for (ProcessorIndex = 0; ProcessorIndex < ThreadCountPerCore[CurrentCore]; ProcessorIndex++) {
-              LibWaitForSemaphore (&SemaphorePtr[CurrentThread]);
-            }
-
+            CurrentCore        = ApLocation->Package * CpuStatus->MaxCoreCount + ApLocation->Core;
+            LibWaitForAllThreads (
+              &CpuFlags->CoreSemaphoreCount[CurrentCore],
+              &CoreGeneration,
+              ThreadCountPerCore[CurrentCore]
+              );
             break;
 
           case PackageDepType:
-            SemaphorePtr          = CpuFlags->PackageSemaphoreCount;
             ThreadCountPerPackage = (UINT32 *)(UINTN)CpuStatus->ThreadCountPerPackage;
-            //
-            // Get Offset info for the first thread in the package which current thread belongs to.
-            //
-            FirstThread = ApLocation->Package * CpuStatus->MaxCoreCount * CpuStatus->MaxThreadCount;
-            //
-            // Get the possible threads count for current package.
-            //
-            CurrentThread = FirstThread + CpuStatus->MaxThreadCount * ApLocation->Core + ApLocation->Thread;
-
-            //
-            // Different packages may have different valid threads in them. If driver maintail clearly
-            // thread index in different packages, the logic will be much complicated.
-            // Here driver just simply records the max thread number in all packages and use it as expect
-            // thread number for all packages.
-            // In below two steps logic, first current thread will Release semaphore for each thread
-            // in current package. Maybe some threads are not valid in this package, but driver don't
-            // care. Second, driver will let current thread wait semaphore for all valid threads in
-            // current package. Because only the valid threads will do release semaphore for this
-            // thread, driver here only need to wait the valid thread count.
-            //
-
-            //
-            // First Notify ALL THREADS in current package that this thread is ready.
-            //
-            for (ProcessorIndex = 0; ProcessorIndex < CpuStatus->MaxThreadCount * CpuStatus->MaxCoreCount; ProcessorIndex++) {
-              LibReleaseSemaphore (&SemaphorePtr[FirstThread + ProcessorIndex]);
-            }
-
-            //
-            // Second, check whether VALID THREADS (not all threads) in current package are ready.
-            //
-            for (ProcessorIndex = 0; ProcessorIndex < ThreadCountPerPackage[ApLocation->Package]; ProcessorIndex++) {
-              LibWaitForSemaphore (&SemaphorePtr[CurrentThread]);
-            }
-
+            LibWaitForAllThreads (
+              &CpuFlags->PackageSemaphoreCount[ApLocation->Package],
+              &PackageGeneration,
+              ThreadCountPerPackage[ApLocation->Package]
+              );
             break;
 
           default:
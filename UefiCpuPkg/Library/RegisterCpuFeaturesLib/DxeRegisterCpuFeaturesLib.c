@@ -229,6 +229,11 @@ CpuFeaturesInitialize (
   OldBspNumber               = GetProcessorIndex (CpuFeaturesData);
   CpuFeaturesData->BspNumber = OldBspNumber;
 
+  //
+  // Semaphore entries in register tables count arrivals from zero.
+  //
+  ResetProcessorRegisterSemaphores (CpuFeaturesData);
+
   //
   //
   // Initialize MpEvent to suppress incorrect compiler/analyzer warnings.
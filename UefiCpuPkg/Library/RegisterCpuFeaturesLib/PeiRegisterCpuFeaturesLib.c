@@ -294,6 +294,11 @@ CpuFeaturesInitialize (
   OldBspNumber               = GetProcessorIndex (CpuFeaturesData);
   CpuFeaturesData->BspNumber = OldBspNumber;
 
+  //
+  // Semaphore entries in register tables count arrivals from zero.
+  //
+  ResetProcessorRegisterSemaphores (CpuFeaturesData);
+
   //
   // Start to program register for all CPUs.
   //
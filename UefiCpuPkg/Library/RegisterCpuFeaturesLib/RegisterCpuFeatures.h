@@ -59,8 +59,8 @@ typedef struct {
 //
 typedef struct {
   volatile UINTN     MemoryMappedLock;              // Spinlock used to program mmio
-  volatile UINT32    *CoreSemaphoreCount;           // Semaphore containers used to program Core semaphore.
-  volatile UINT32    *PackageSemaphoreCount;        // Semaphore containers used to program Package semaphore.
+  volatile UINT32    *CoreSemaphoreCount;           // Arrival counters used to program Core semaphore, one per core.
+  volatile UINT32    *PackageSemaphoreCount;        // Arrival counters used to program Package semaphore, one per package.
 } PROGRAM_CPU_REGISTER_FLAGS;
 
 typedef union {
@@ -233,6 +233,18 @@ DetectNoneNeighborhoodFeatureScope (
   IN LIST_ENTRY          *FeatureList
   );
 
+/**
+  Reset the arrival counters used by the semaphore entries in register tables.
+
+  @param[in] CpuFeaturesData  Pointer to CPU_FEATURES_DATA.
+
+  @note This service could be called by BSP only, before any processor programs its register table.
+**/
+VOID
+ResetProcessorRegisterSemaphores (
+  IN CPU_FEATURES_DATA  *CpuFeaturesData
+  );
+
 /**
   Programs registers for the calling processor.
 
@@ -40,6 +40,14 @@
 ///
 typedef volatile UINT32 SMM_CPU_SYNC_SEMAPHORE;
 
+///
+/// Number of CPUs which signal the BSP through the same semaphore.
+/// CPU indexes follow the APIC ID order, so the CPUs sharing one semaphore
+/// are usually siblings in the same package, and the BSP arrival semaphore
+/// cache line is no longer bounced between all CPUs in the system.
+///
+#define SMM_CPU_SYNC_CPUS_PER_BSP_SEMAPHORE  16
+
 typedef struct {
   ///
   /// Used for control each CPU continue run or wait for signal
@@ -61,6 +69,20 @@ struct SMM_CPU_SYNC_CONTEXT  {
   ///
   UINTN                                  SemBufferPages;
   ///
+  /// Size of one semaphore, which is the size of one cache line.
+  ///
+  UINTN                                  SemSize;
+  ///
+  /// Semaphores used by APs to release BSP, one for every
+  /// SMM_CPU_SYNC_CPUS_PER_BSP_SEMAPHORE CPUs. They are placed back to back,
+  /// SemSize bytes apart.
+  ///
+  SMM_CPU_SYNC_SEMAPHORE                 *BspRun;
+  ///
+  /// Number of semaphores in BspRun.
+  ///
+  UINTN                                  BspRunCount;
+  ///
   /// Before the door is locked, CpuCount stores the arrived CPU count.
   /// After the door is locked, CpuCount is set to -1 indicating the door is locked.
   /// ArrivedCpuCountUponLock stores the arrived CPU count then.
@@ -158,6 +180,64 @@ InternalReleaseSemaphore (
   return Value + 1;
 }
 
+/**
+  Performs an atomic compare exchange operation to take up to MaxCount from
+  semaphore without waiting.
+  The compare exchange operation must be performed using MP safe
+  mechanisms.
+
+  @param[in,out]  Sem       IN:  32-bit unsigned integer
+                            OUT: original integer - return value
+  @param[in]      MaxCount  Maximum count to take from Sem.
+
+  @retval    The count taken from Sem. 0 if Sem is 0.
+
+**/
+STATIC
+UINT32
+InternalTakeFromSemaphore (
+  IN OUT  volatile UINT32  *Sem,
+  IN      UINT32           MaxCount
+  )
+{
+  UINT32  Value;
+  UINT32  Count;
+
+  do {
+    Value = *Sem;
+    if (Value == 0) {
+      return 0;
+    }
+
+    Count = MIN (Value, MaxCount);
+  } while (InterlockedCompareExchange32 (
+             (UINT32 *)Sem,
+             Value,
+             Value - Count
+             ) != Value);
+
+  return Count;
+}
+
+/**
+  Get the semaphore used by the AP to release BSP.
+
+  @param[in]  Context     Pointer to the SMM CPU Sync context object.
+  @param[in]  Index       Index of the semaphore in BspRun.
+
+  @return  Pointer to the semaphore.
+
+**/
+STATIC
+SMM_CPU_SYNC_SEMAPHORE *
+InternalGetBspRun (
+  IN SMM_CPU_SYNC_CONTEXT  *Context,
+  IN UINTN                 Index
+  )
+{
+  return (SMM_CPU_SYNC_SEMAPHORE *)((UINTN)Context->BspRun + Index * Context->SemSize);
+}
+
 /**
   Performs an atomic compare exchange operation to lock semaphore.
   The compare exchange operation must be performed using MP safe
@@ -217,6 +297,7 @@ SmmCpuSyncContextInit (
   UINTN                                TotalSemSize;
   UINTN                                SemAddr;
   UINTN                                CpuIndex;
+  UINTN                                BspRunCount;
   SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_CPU  *CpuSem;
 
   ASSERT (Context != NULL);
@@ -255,7 +336,13 @@ SmmCpuSyncContextInit (
   OneSemSize = GetSpinLockProperties ();
   ASSERT (sizeof (SMM_CPU_SYNC_SEMAPHORE) <= OneSemSize);
 
-  Status = SafeUintnAdd (1, NumberOfCpus, &NumSem);
+  BspRunCount = (NumberOfCpus + SMM_CPU_SYNC_CPUS_PER_BSP_SEMAPHORE - 1) / SMM_CPU_SYNC_CPUS_PER_BSP_SEMAPHORE;
+  Status      = SafeUintnAdd (1, NumberOfCpus, &NumSem);
+  if (RETURN_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = SafeUintnAdd (NumSem, BspRunCount, &NumSem);
   if (RETURN_ERROR (Status)) {
     goto ON_ERROR;
   }
@@ -296,6 +383,16 @@ SmmCpuSyncContextInit (
     SemAddr += OneSemSize;
   }
 
+  //
+  // Assign BSP Semaphore pointers
+  //
+  (*Context)->SemSize     = OneSemSize;
+  (*Context)->BspRun      = (SMM_CPU_SYNC_SEMAPHORE *)SemAddr;
+  (*Context)->BspRunCount = BspRunCount;
+  for (CpuIndex = 0; CpuIndex < BspRunCount; CpuIndex++) {
+    *InternalGetBspRun (*Context, CpuIndex) = 0;
+  }
+
   return RETURN_SUCCESS;
 
 ON_ERROR:
@@ -528,7 +625,9 @@ SmmCpuSyncWaitForAPs (
   IN     UINTN                 BspIndex
   )
 {
-  UINTN  Arrived;
+  UINTN   Remaining;
+  UINTN   Index;
+  UINT32  Taken;
 
   ASSERT (Context != NULL);
 
@@ -536,8 +635,20 @@ SmmCpuSyncWaitForAPs (
 
   ASSERT (BspIndex < Context->NumberOfCpus);
 
-  for (Arrived = 0; Arrived < NumberOfAPs; Arrived++) {
-    InternalWaitForSemaphore (Context->CpuSem[BspIndex].Run);
+  //
+  // Collect the releases from all BSP semaphores, taking as many as are
+  // available from each one with a single atomic operation.
+  //
+  Remaining = NumberOfAPs;
+  Index     = 0;
+  while (Remaining != 0) {
+    Taken      = InternalTakeFromSemaphore (InternalGetBspRun (Context, Index), (UINT32)Remaining);
+    Remaining -= Taken;
+    Index++;
+    if (Index == Context->BspRunCount) {
+      Index = 0;
+      CpuPause ();
+    }
   }
 }
 
@@ -648,5 +759,5 @@ SmmCpuSyncReleaseBsp (
 
   ASSERT (BspIndex < Context->NumberOfCpus);
 
-  InternalReleaseSemaphore (Context->CpuSem[BspIndex].Run);
+  InternalReleaseSemaphore (InternalGetBspRun (Context, CpuIndex / SMM_CPU_SYNC_CPUS_PER_BSP_SEMAPHORE));
 }